@@ -0,0 +1,73 @@
+// Cost of the command audit ring on the post/consume path.
+//
+// Two registries with identical keys, one with Options<Key>::audit_depth set:
+// reported ns per post() + consume() pair, and per post() alone.
+
+#include <cstdio>
+#include <memory>
+
+#include "bench_util.hpp"
+#include "regbus/Registry.hpp"
+
+enum class Plain : uint8_t
+{
+    CMD
+};
+enum class Audited : uint8_t
+{
+    CMD
+};
+
+struct Cmd
+{
+    uint32_t id;
+    float arg[3];
+};
+
+template <Plain>
+struct PlainTraits
+{
+    using type = Cmd;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+template <Audited>
+struct AuditedTraits
+{
+    using type = Cmd;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+template <>
+struct regbus::Options<Audited>
+{
+    static constexpr std::size_t audit_depth = 4096;
+};
+
+using RP = regbus::Registry<Plain, PlainTraits, Plain::CMD>;
+using RA = regbus::Registry<Audited, AuditedTraits, Audited::CMD>;
+
+template <typename R, typename R::key_type K>
+static void run(const char *name)
+{
+    auto r = std::make_unique<R>();
+    Cmd c{1, {1.f, 2.f, 3.f}}, out{};
+    const double pair = bench::ns_per_op([&]
+                                         {
+        ++c.id;
+        r->template post<K>(c);
+        r->template consume<K>(out);
+        bench::keep(out); });
+    const double post = bench::ns_per_op([&]
+                                         {
+        ++c.id;
+        r->template post<K>(c); });
+    std::printf("%-8s %10.1f %10.1f\n", name, pair, post);
+}
+
+int main()
+{
+    std::printf("%-8s %10s %10s\n", "", "post+cons", "post");
+    run<RP, Plain::CMD>("plain");
+    run<RA, Audited::CMD>("audited");
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Per-key copy policies for large DBReg payloads, measured on co-running work.
+//
+// 1) Writer cache pollution: one thread alternates a pass over its own hot
+//    working set (sized to fit L2) with publishing a large payload. With
+//    PlainCopy the publish evicts the working set; with StreamingCopy
+//    (non-temporal stores) it should not. Reported: ns per working-set pass.
+// 2) Reader latency: a writer thread keeps publishing while the reader
+//    copies the payload out with PlainCopy vs PrefetchCopy. Reported: ns
+//    per read().
+//
+// Usage: bench_copy [working_set_KiB=512]
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "regbus/DBReg.hpp"
+
+template <std::size_t Bytes>
+struct Payload
+{
+    uint8_t b[Bytes];
+};
+
+template <std::size_t Bytes, typename Copy>
+static double writer_pass_ns(std::vector<uint64_t> &ws, int iters)
+{
+    using P = Payload<Bytes>;
+    auto reg = std::make_unique<regbus::DBReg<P, Copy>>();
+    auto src = std::make_unique<P>();
+    for (std::size_t i = 0; i < Bytes; ++i)
+        src->b[i] = uint8_t(i);
+
+    uint64_t total = 0, acc = 0;
+    for (int it = 0; it < iters; ++it)
+    {
+        const uint64_t t0 = bench::now_ns();
+        for (uint64_t v : ws)
+            acc += v;
+        total += bench::now_ns() - t0;
+        src->b[0] = uint8_t(it);
+        reg->write(*src);
+    }
+    bench::keep(acc);
+    return double(total) / iters;
+}
+
+template <std::size_t Bytes, typename Copy>
+static double reader_ns(int iters)
+{
+    using P = Payload<Bytes>;
+    auto reg = std::make_unique<regbus::DBReg<P, Copy>>();
+    auto src = std::make_unique<P>();
+    auto out = std::make_unique<P>();
+    std::atomic<bool> run{true};
+    reg->write(*src);
+
+    std::thread w([&]
+                  {
+        uint8_t i = 0;
+        while (run.load(std::memory_order_relaxed)) {
+            src->b[0] = i++;
+            reg->write(*src);
+        } });
+
+    uint64_t total = 0;
+    for (int it = 0; it < iters; ++it)
+    {
+        const uint64_t t0 = bench::now_ns();
+        reg->read(*out);
+        total += bench::now_ns() - t0;
+        bench::keep(out->b[0]);
+    }
+    run = false;
+    w.join();
+    return double(total) / iters;
+}
+
+template <std::size_t Bytes>
+static void run(std::vector<uint64_t> &ws)
+{
+    constexpr int iters = 400;
+    const double plain = writer_pass_ns<Bytes, regbus::PlainCopy>(ws, iters);
+    const double stream = writer_pass_ns<Bytes, regbus::StreamingCopy<0>>(ws, iters);
+    const double rplain = reader_ns<Bytes, regbus::PlainCopy>(iters);
+    const double rpref = reader_ns<Bytes, regbus::PrefetchCopy<0>>(iters);
+    std::printf("%7zu KiB | working-set pass %9.0f ns plain %9.0f ns streaming (%+5.1f%%)"
+                " | read %9.0f ns plain %9.0f ns prefetch (%+5.1f%%)\n",
+                Bytes / 1024, plain, stream, 100.0 * (stream - plain) / plain,
+                rplain, rpref, 100.0 * (rpref - rplain) / rplain);
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t ws_kib = argc > 1 ? std::size_t(std::atoi(argv[1])) : 512;
+    std::vector<uint64_t> ws(ws_kib * 1024 / sizeof(uint64_t), 1);
+    std::printf("working set %zu KiB, %s, %u hw threads\n", ws_kib,
+                REGBUS_HAS_NT_STORES ? "non-temporal stores available" : "no NT stores: memcpy fallback",
+                std::thread::hardware_concurrency());
+    run<64 * 1024>(ws);
+    run<256 * 1024>(ws);
+    run<1024 * 1024>(ws);
+    return 0;
+}
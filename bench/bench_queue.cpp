@@ -0,0 +1,86 @@
+// MPMC work queue (Kind::Queue) throughput from 1 to 16 consumers.
+//
+// Two producers push a fixed number of jobs; C consumers drain them with
+// pop() (batch 1) and pop_batch() (batch 8). Reported per row: total Mjobs/s
+// and fairness as the min/max share of jobs taken per consumer (1.0 = even).
+// Results beyond the machine's core count mostly measure oversubscription.
+//
+// Usage: bench_queue [jobs=2000000]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "regbus/QueueReg.hpp"
+
+using Q = regbus::QueueReg<uint64_t, 1024, 16>;
+
+static void run(std::size_t consumers, std::size_t batch, uint64_t jobs)
+{
+    auto q = std::make_unique<Q>();
+    std::atomic<uint64_t> taken{0};
+    std::atomic<bool> go{false};
+
+    auto producer = [&](uint64_t n)
+    {
+        while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        for (uint64_t i = 0; i < n; ++i)
+            while (!q->push(i))
+                std::this_thread::yield();
+    };
+    auto consumer = [&](std::size_t id)
+    {
+        uint64_t buf[8], sum = 0;
+        while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        while (taken.load(std::memory_order_relaxed) < jobs)
+        {
+            const std::size_t n = q->pop_batch(buf, batch, id);
+            if (n == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                sum += buf[i];
+            taken.fetch_add(n, std::memory_order_relaxed);
+        }
+        bench::keep(sum);
+    };
+
+    std::vector<std::thread> th;
+    for (std::size_t c = 0; c < consumers; ++c)
+        th.emplace_back(consumer, c);
+    th.emplace_back(producer, jobs / 2);
+    th.emplace_back(producer, jobs - jobs / 2);
+    const uint64_t t0 = bench::now_ns();
+    go.store(true, std::memory_order_release);
+    for (auto &t : th)
+        t.join();
+    const double sec = double(bench::now_ns() - t0) / 1e9;
+
+    uint64_t lo = ~uint64_t(0), hi = 0;
+    for (std::size_t c = 0; c < consumers; ++c)
+    {
+        lo = std::min(lo, q->claimed(c));
+        hi = std::max(hi, q->claimed(c));
+    }
+    std::printf("%9zu %6zu %10.2f %9.2f\n", consumers, batch, double(jobs) / sec / 1e6,
+                hi ? double(lo) / double(hi) : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    const uint64_t jobs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::printf("%9s %6s %10s %9s\n", "consumers", "batch", "Mjobs/s", "fairness");
+    for (std::size_t batch : {std::size_t(1), std::size_t(8)})
+        for (std::size_t c : {1, 2, 4, 8, 16})
+            run(c, batch, jobs);
+    return 0;
+}
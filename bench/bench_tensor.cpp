@@ -0,0 +1,70 @@
+// Publish/consume cost of large numeric payloads: DBReg<std::array<float, N>>
+// (16-byte aligned slots, plain copies) against TensorReg<Tensor<float, N>>
+// (64-byte aligned slots, streaming publish above REGBUS_NT_THRESHOLD, and
+// in-place visit() that computes on the slot without copying it out).
+//
+// Single-threaded: isolates copy cost from coherence traffic.
+
+#include <array>
+#include <cstdio>
+#include <memory>
+
+#include "bench_util.hpp"
+#include "regbus/DBReg.hpp"
+#include "regbus/TensorReg.hpp"
+
+template <std::size_t Bytes>
+static void run()
+{
+    constexpr std::size_t N = Bytes / sizeof(float);
+    using Arr = std::array<float, N>;
+    using Ten = regbus::Tensor<float, N>;
+
+    auto db = std::make_unique<regbus::DBReg<Arr>>();
+    auto tr = std::make_unique<regbus::TensorReg<Ten>>();
+    auto a = std::make_unique<Arr>();
+    auto t = std::make_unique<Ten>();
+    for (std::size_t i = 0; i < N; ++i)
+        (*a)[i] = t->data[i] = float(i);
+
+    const double db_w = bench::ns_per_op([&]
+                                         { db->write(*a); });
+    const double db_r = bench::ns_per_op([&]
+                                         { db->read(*a); bench::keep((*a)[0]); });
+    const double tr_w = bench::ns_per_op([&]
+                                         { tr->write(*t); });
+    const double tr_r = bench::ns_per_op([&]
+                                         { tr->read(*t); bench::keep(t->data[0]); });
+    const double tr_v = bench::ns_per_op([&]
+                                         {
+        float s = 0;
+        tr->visit([&](const Ten &x) { s = 0; for (float f : x.data) s += f; });
+        bench::keep(s); });
+    const double cp_s = bench::ns_per_op([&]
+                                         {
+        float s = 0;
+        db->read(*a);
+        for (float f : *a) s += f;
+        bench::keep(s); });
+
+    auto gbs = [](double ns)
+    { return double(Bytes) / ns; };
+    std::printf("%8zu KiB | write %9.0f ns %6.1f GB/s | %9.0f ns %6.1f GB/s | read %9.0f ns | %9.0f ns"
+                " | sum(copy) %9.0f ns | sum(visit) %9.0f ns\n",
+                Bytes / 1024, db_w, gbs(db_w), tr_w, gbs(tr_w), db_r, tr_r, cp_s, tr_v);
+}
+
+int main()
+{
+    std::printf("payload      |        DBReg write             |       TensorReg write          |"
+                " DBReg read     | TensorReg read | reduce\n");
+    std::printf("(NT threshold %u bytes, %s)\n", unsigned(REGBUS_NT_THRESHOLD),
+                REGBUS_HAS_NT_STORES ? "non-temporal stores available" : "no NT stores: memcpy fallback");
+    run<1024>();
+    run<4 * 1024>();
+    run<16 * 1024>();
+    run<64 * 1024>();
+    run<256 * 1024>();
+    run<1024 * 1024>();
+    return 0;
+}
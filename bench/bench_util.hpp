@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Minimal timing helpers for the regbus benchmarks (no external deps)
+namespace bench
+{
+    inline uint64_t now_ns()
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count());
+    }
+
+    // Runs f() in batches until at least min_ms elapsed; returns ns per call
+    template <typename F>
+    double ns_per_op(F &&f, uint64_t min_ms = 100)
+    {
+        f(); // warm up
+        uint64_t n = 0, batch = 1;
+        const uint64_t t0 = now_ns();
+        uint64_t t = t0;
+        while (t - t0 < min_ms * 1000000ull)
+        {
+            for (uint64_t i = 0; i < batch; ++i)
+                f();
+            n += batch;
+            batch *= 2;
+            t = now_ns();
+        }
+        return double(t - t0) / double(n);
+    }
+
+    // Keeps v observable so the compiler cannot drop the work that produced it
+    template <typename T>
+    inline void keep(const T &v)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(v) : "memory");
+#else
+        static volatile const T *sink;
+        sink = &v;
+#endif
+    }
+} // namespace bench
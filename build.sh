@@ -5,6 +5,7 @@
 #   ./build.sh --debug              # Debug build
 #   ./build.sh --release            # Release build
 #   ./build.sh --no-tests --no-examples
+#   ./build.sh --release --benchmarks  # also build bench/ (bench_tensor, ...)
 #   ./build.sh --run-tests
 #   ./build.sh --run-example        # runs examples/minimal_registry after building
 #   ./build.sh --clean              # delete build dir
@@ -17,6 +18,7 @@ BUILD_DIR="build"
 BUILD_TYPE="RelWithDebInfo"
 WITH_TESTS="ON"
 WITH_EXAMPLES="ON"
+WITH_BENCHMARKS="OFF"
 RUN_TESTS="OFF"
 RUN_EXAMPLE="OFF"
 INSTALL_PREFIX=""
@@ -49,6 +51,7 @@ Options:
 
   --no-tests           Disable building tests (default: ON)
   --no-examples        Disable building examples (default: ON)
+  --benchmarks         Build benchmarks in bench/ (default: OFF; use with --release)
   --run-tests          Run ctest after build
   --run-example        Run the minimal example after build
 
@@ -73,6 +76,7 @@ while [[ $# -gt 0 ]]; do
     --minsizerel) BUILD_TYPE="MinSizeRel"; shift ;;
     --no-tests) WITH_TESTS="OFF"; shift ;;
     --no-examples) WITH_EXAMPLES="OFF"; shift ;;
+    --benchmarks) WITH_BENCHMARKS="ON"; shift ;;
     --run-tests) RUN_TESTS="ON"; shift ;;
     --run-example) RUN_EXAMPLE="ON"; shift ;;
     --install) INSTALL_PREFIX="${2?}"; shift 2 ;;
@@ -91,6 +95,7 @@ set -x
 cmake -S . -B "${BUILD_DIR}" ${GENERATOR} \
   -DREGBUS_BUILD_TESTS="${WITH_TESTS}" \
   -DREGBUS_BUILD_EXAMPLES="${WITH_EXAMPLES}" \
+  -DREGBUS_BUILD_BENCHMARKS="${WITH_BENCHMARKS}" \
   -DCMAKE_BUILD_TYPE="${BUILD_TYPE}" \
   ${INSTALL_PREFIX:+-DCMAKE_INSTALL_PREFIX="${INSTALL_PREFIX}"}
 set +x
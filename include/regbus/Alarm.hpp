@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace regbus
+{
+    // Alarm state of a limit-checked key
+    enum class AlarmLevel : uint8_t
+    {
+        None,
+        Low,
+        High
+    };
+
+    // Posted to a key's Traits::alarm_cmd key on every alarm edge
+    struct AlarmEvent
+    {
+        uint16_t key;     // Registry::index<K>() of the key that changed state
+        AlarmLevel level; // new level (None = cleared)
+    };
+
+    // Optional Traits members for Data/Ring keys with an arithmetic type:
+    //   static constexpr type alarm_hi   = ...;  // raise High when v > alarm_hi
+    //   static constexpr type alarm_lo   = ...;  // raise Low  when v < alarm_lo
+    //   static constexpr type alarm_hyst = ...;  // clear only once back inside by this much (default 0)
+    //   static constexpr Key  alarm_cmd  = ...;  // Cmd key of type AlarmEvent, posted on every edge
+    namespace detail
+    {
+        template <typename Tr, typename = void>
+        struct has_alarm_hi : std::false_type
+        {
+        };
+        template <typename Tr>
+        struct has_alarm_hi<Tr, std::void_t<decltype(Tr::alarm_hi)>> : std::true_type
+        {
+        };
+
+        template <typename Tr, typename = void>
+        struct has_alarm_lo : std::false_type
+        {
+        };
+        template <typename Tr>
+        struct has_alarm_lo<Tr, std::void_t<decltype(Tr::alarm_lo)>> : std::true_type
+        {
+        };
+
+        template <typename Tr, typename = void>
+        struct has_alarm_cmd : std::false_type
+        {
+        };
+        template <typename Tr>
+        struct has_alarm_cmd<Tr, std::void_t<decltype(Tr::alarm_cmd)>> : std::true_type
+        {
+        };
+
+        template <typename Tr>
+        struct has_alarm : std::integral_constant<bool, has_alarm_hi<Tr>::value || has_alarm_lo<Tr>::value>
+        {
+        };
+
+        template <typename Tr, typename = void>
+        struct alarm_hyst
+        {
+            static constexpr typename Tr::type value{};
+        };
+        template <typename Tr>
+        struct alarm_hyst<Tr, std::void_t<decltype(Tr::alarm_hyst)>>
+        {
+            static constexpr typename Tr::type value = Tr::alarm_hyst;
+        };
+
+        // New (high, low) state for v given the current state. Hysteresis
+        // only applies while in alarm, selected without branching on the state.
+        template <typename Tr>
+        inline void alarm_eval(const typename Tr::type &v, bool in_hi, bool in_lo, bool &hi, bool &lo)
+        {
+            using T = typename Tr::type;
+            static_assert(std::is_arithmetic<T>::value, "alarm limits require an arithmetic Traits::type");
+            constexpr T h = alarm_hyst<Tr>::value;
+            hi = false;
+            lo = false;
+            if constexpr (has_alarm_hi<Tr>::value)
+            {
+                const T lim = in_hi ? T(Tr::alarm_hi - h) : T(Tr::alarm_hi);
+                hi = v > lim;
+            }
+            if constexpr (has_alarm_lo<Tr>::value)
+            {
+                const T lim = in_lo ? T(Tr::alarm_lo + h) : T(Tr::alarm_lo);
+                lo = v < lim;
+            }
+        }
+    } // namespace detail
+} // namespace regbus
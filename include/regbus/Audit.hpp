@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define REGBUS_AUDIT_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define REGBUS_AUDIT_TSC 1
+#else
+#define REGBUS_AUDIT_TSC 0
+#endif
+
+namespace regbus
+{
+    // One audited command, as handed to AuditRing::dump()
+    template <std::size_t MaxBytes>
+    struct AuditRecord
+    {
+        uint64_t seq;        // 1-based post number
+        uint64_t post_us;    // steady clock
+        uint64_t consume_us; // 0 = not consumed (superseded or still pending)
+        uint32_t thread;     // poster's regbus thread tag (see detail::thread_tag)
+        uint16_t key;        // Registry::index<K>()
+        uint16_t size;       // sizeof the value (bytes kept: min(size, MaxBytes))
+        bool superseded;     // replaced by a later post before anyone consumed it
+        uint8_t value[MaxBytes];
+    };
+
+    namespace detail
+    {
+        inline uint64_t audit_now_us()
+        {
+            return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+        }
+
+        // Cheap monotonic ticks for the hot path: TSC where available (a
+        // steady_clock read costs ~40 ns on some VMs), else steady_clock ns.
+        // Converted to steady-clock microseconds only when dumping.
+        inline uint64_t audit_ticks()
+        {
+#if REGBUS_AUDIT_TSC
+            return __rdtsc();
+#else
+            return uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        // Small dense per-thread id (1, 2, ...), assigned on first use
+        inline uint32_t thread_tag()
+        {
+            static std::atomic<uint32_t> next{0};
+            thread_local const uint32_t tag = next.fetch_add(1, std::memory_order_relaxed) + 1;
+            return tag;
+        }
+    } // namespace detail
+
+    // AuditRing<Depth, MaxBytes>: lock-free log of the last Depth command
+    // posts. Posters claim a slot with one fetch_add and fill it under a
+    // per-slot stamp (odd while writing). The record's seq travels with the
+    // command in its register slot: the consume path stamps the consume time
+    // into exactly the record it took, and a post that replaces a pending
+    // command marks that command's record superseded. dump() copies every
+    // settled record, oldest first, without stopping writers.
+    // Times are taken as raw ticks and mapped to steady-clock microseconds
+    // at dump() from two (ticks, us) anchors: construction and the dump.
+    template <std::size_t Depth, std::size_t MaxBytes = 16>
+    class AuditRing
+    {
+        static_assert(Depth >= 1, "AuditRing: Depth must be >= 1");
+
+    public:
+        using record_type = AuditRecord<MaxBytes>;
+        static constexpr std::size_t depth = Depth;
+
+        AuditRing() : anchor_tk_(detail::audit_ticks()), anchor_us_(detail::audit_now_us()) {}
+
+        // Returns the record's seq (pass to consumed())
+        inline uint64_t posted(uint16_t key, const void *v, std::size_t n)
+        {
+            const uint64_t seq = head_.fetch_add(1, std::memory_order_relaxed) + 1;
+            Slot &s = slot_[(seq - 1) % Depth];
+            s.stamp.store(2 * seq - 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            s.consume_tk.store(0, std::memory_order_relaxed);
+            s.post_tk = detail::audit_ticks();
+            s.thread = detail::thread_tag();
+            s.key = key;
+            s.size = uint16_t(n);
+            std::memcpy(s.value, v, n < MaxBytes ? n : MaxBytes);
+            s.stamp.store(2 * seq, std::memory_order_release);
+            return seq;
+        }
+
+        // Stamps the consume time if the record has not been overwritten.
+        // (A wrap of the whole ring between the check and the store would
+        // misattribute the time; that takes Depth posts within a few ns.)
+        inline void consumed(uint64_t seq)
+        {
+            Slot &s = slot_[(seq - 1) % Depth];
+            if (s.stamp.load(std::memory_order_acquire) == 2 * seq)
+                s.consume_tk.store(detail::audit_ticks(), std::memory_order_release);
+        }
+
+        // Marks a record whose command was replaced before it was consumed
+        inline void superseded(uint64_t seq)
+        {
+            Slot &s = slot_[(seq - 1) % Depth];
+            if (s.stamp.load(std::memory_order_acquire) == 2 * seq)
+                s.consume_tk.store(superseded_tk, std::memory_order_release);
+        }
+
+        // Calls f(const record_type &) for each settled record, oldest first
+        template <typename F>
+        inline void dump(F &&f) const
+        {
+            const uint64_t head = head_.load(std::memory_order_acquire);
+            const uint64_t now_tk = detail::audit_ticks(), now_us = detail::audit_now_us();
+            const double us_per_tk = now_tk > anchor_tk_ ? double(now_us - anchor_us_) / double(now_tk - anchor_tk_) : 0.0;
+            auto to_us = [&](uint64_t tk)
+            { return tk > anchor_tk_ ? anchor_us_ + uint64_t(double(tk - anchor_tk_) * us_per_tk) : anchor_us_; };
+            record_type r;
+            for (uint64_t seq = head > Depth ? head - Depth + 1 : 1; seq <= head; ++seq)
+            {
+                const Slot &s = slot_[(seq - 1) % Depth];
+                if (s.stamp.load(std::memory_order_acquire) != 2 * seq)
+                    continue; // in progress or already overwritten
+                r.seq = seq;
+                const uint64_t post_tk = s.post_tk;
+                r.thread = s.thread;
+                r.key = s.key;
+                r.size = s.size;
+                std::memcpy(r.value, s.value, MaxBytes);
+                const uint64_t consume_tk = s.consume_tk.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.stamp.load(std::memory_order_relaxed) != 2 * seq)
+                    continue;
+                r.post_us = to_us(post_tk);
+                r.superseded = consume_tk == superseded_tk;
+                r.consume_us = consume_tk && !r.superseded ? to_us(consume_tk) : 0;
+                f(static_cast<const record_type &>(r));
+            }
+        }
+
+        // Posts recorded so far (including ones since overwritten)
+        inline uint64_t recorded() const { return head_.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr uint64_t superseded_tk = ~uint64_t(0); // in consume_tk
+
+        struct Slot
+        {
+            std::atomic<uint64_t> stamp{0}; // 2*seq when settled, odd while writing
+            std::atomic<uint64_t> consume_tk{0};
+            uint64_t post_tk = 0;
+            uint32_t thread = 0;
+            uint16_t key = 0;
+            uint16_t size = 0;
+            uint8_t value[MaxBytes]{};
+        };
+
+        const uint64_t anchor_tk_, anchor_us_;
+        alignas(64) std::atomic<uint64_t> head_{0};
+        alignas(64) Slot slot_[Depth];
+    };
+} // namespace regbus
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Futex.hpp"
+
+namespace regbus
+{
+    namespace detail
+    {
+        inline unsigned popcount64(uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return unsigned(__builtin_popcountll(x));
+#else
+            unsigned n = 0;
+            for (; x; x &= x - 1)
+                ++n;
+            return n;
+#endif
+        }
+        inline unsigned ctz64(uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return x ? unsigned(__builtin_ctzll(x)) : 64u;
+#else
+            unsigned n = 0;
+            for (uint64_t m = 1; m && !(x & m); m <<= 1)
+                ++n;
+            return n;
+#endif
+        }
+    } // namespace detail
+
+    // BitReg<N>: N boolean flags packed into atomic 64-bit slots, 32 flags
+    // in the low half and a 32-bit version in the high half of each.
+    //
+    // set/clear/toggle/assign are one atomic CAS on the flag's slot (any
+    // thread, lock-free) that flips the flag and bumps the slot's version,
+    // and return the previous value, so callers get edges for free. Setting
+    // a set flag (clearing a clear one) is a load only: no CAS, no version.
+    // An index >= N is ignored (mutators and test() return false); the
+    // set<I>() forms check I at compile time.
+    // test/any/count/find_first read the live slots. There is no shared
+    // counter: writers to different slots never touch the same word.
+    //
+    // snapshot() returns a coherent copy of all flags: it reads every slot
+    // twice and accepts when both reads match. Versions make a flag that
+    // changed and changed back show up, and a retry only happens when some
+    // writer completed in between (lock-free, never waits on a writer).
+    // words, word(w) and snapshot() present the flags as 64-bit words.
+    template <std::size_t N>
+    class BitReg
+    {
+        static_assert(N > 0, "BitReg: N must be > 0");
+
+    public:
+        static constexpr std::size_t bits = N;
+        static constexpr std::size_t words = (N + 63) / 64;
+
+        inline bool set(std::size_t i) { return rmw(i, Op::Set); }
+        inline bool clear(std::size_t i) { return rmw(i, Op::Clear); }
+        inline bool toggle(std::size_t i) { return rmw(i, Op::Toggle); }
+        inline bool assign(std::size_t i, bool on) { return rmw(i, on ? Op::Set : Op::Clear); }
+
+        inline bool test(std::size_t i) const
+        {
+            return i < N && (s_[i / 32].load(std::memory_order_acquire) >> (i % 32)) & 1u;
+        }
+
+        template <std::size_t I>
+        inline bool set() { return checked<I>(), rmw(I, Op::Set); }
+        template <std::size_t I>
+        inline bool clear() { return checked<I>(), rmw(I, Op::Clear); }
+        template <std::size_t I>
+        inline bool toggle() { return checked<I>(), rmw(I, Op::Toggle); }
+        template <std::size_t I>
+        inline bool test() const { return checked<I>(), test(I); }
+
+        inline uint64_t word(std::size_t w) const
+        {
+            const uint64_t lo = flags_of(s_[2 * w].load(std::memory_order_acquire));
+            const uint64_t hi = 2 * w + 1 < slots ? flags_of(s_[2 * w + 1].load(std::memory_order_acquire)) : 0;
+            return lo | hi << 32;
+        }
+
+        inline bool any() const
+        {
+            for (std::size_t k = 0; k < slots; ++k)
+                if (flags_of(s_[k].load(std::memory_order_acquire)))
+                    return true;
+            return false;
+        }
+
+        inline std::size_t count() const
+        {
+            std::size_t n = 0;
+            for (std::size_t k = 0; k < slots; ++k)
+                n += detail::popcount64(flags_of(s_[k].load(std::memory_order_acquire)));
+            return n;
+        }
+
+        // Index of the first set flag at or after from; N if none
+        inline std::size_t find_first(std::size_t from = 0) const
+        {
+            if (from >= N)
+                return N;
+            std::size_t w = from / 64;
+            uint64_t x = word(w) & (~uint64_t(0) << (from % 64));
+            for (;;)
+            {
+                if (x)
+                    return w * 64 + detail::ctz64(x);
+                if (++w == words)
+                    return N;
+                x = word(w);
+            }
+        }
+
+        // Coherent copy of all flags (double read; retries only when a
+        // mutation completed between the two reads)
+        inline void snapshot(uint64_t (&out)[words]) const
+        {
+            uint64_t a[slots];
+            for (std::size_t k = 0; k < slots; ++k)
+                a[k] = s_[k].load(std::memory_order_acquire);
+            for (;;)
+            {
+                bool same = true;
+                for (std::size_t k = 0; k < slots; ++k)
+                {
+                    const uint64_t v = s_[k].load(std::memory_order_acquire);
+                    same &= v == a[k];
+                    a[k] = v;
+                }
+                if (same)
+                    break;
+            }
+            for (std::size_t w = 0; w < words; ++w)
+                out[w] = flags_of(a[2 * w]) | (2 * w + 1 < slots ? flags_of(a[2 * w + 1]) << 32 : 0);
+        }
+
+        // Completed mutations so far, mod 2^32 (cheap change detection for pollers)
+        inline uint32_t seq() const { return version(std::memory_order_acquire); }
+
+        // No mutation is ever half done: started == published
+        inline WaitStamp stamp() const
+        {
+            const uint32_t v = version(std::memory_order_seq_cst);
+            return {v, v};
+        }
+
+    private:
+        enum class Op : uint8_t
+        {
+            Set,
+            Clear,
+            Toggle
+        };
+
+        static constexpr std::size_t slots = (N + 31) / 32;
+        static constexpr uint64_t version_one = uint64_t(1) << 32;
+
+        static inline uint64_t flags_of(uint64_t s) { return s & 0xFFFFFFFFu; }
+
+        template <std::size_t I>
+        static constexpr void checked() { static_assert(I < N, "BitReg: flag index out of range"); }
+
+        inline uint32_t version(std::memory_order mo) const
+        {
+            uint32_t v = 0;
+            for (std::size_t k = 0; k < slots; ++k)
+                v += uint32_t(s_[k].load(mo) >> 32);
+            return v;
+        }
+
+        inline bool rmw(std::size_t i, Op op)
+        {
+            if (i >= N)
+                return false;
+            return rmw(s_[i / 32], uint64_t(1) << (i % 32), op);
+        }
+
+        static inline bool rmw(std::atomic<uint64_t> &s, uint64_t m, Op op)
+        {
+            uint64_t old = s.load(std::memory_order_acquire), next;
+            do
+            {
+                if (op != Op::Toggle && ((old & m) != 0) == (op == Op::Set))
+                    return op == Op::Set; // already there: nothing to publish
+                switch (op)
+                {
+                case Op::Set:
+                    next = old | m;
+                    break;
+                case Op::Clear:
+                    next = old & ~m;
+                    break;
+                default:
+                    next = old ^ m;
+                    break;
+                }
+                next += version_one; // wraps within the high half
+            } while (!s.compare_exchange_weak(old, next, std::memory_order_seq_cst, std::memory_order_relaxed));
+            return (old & m) != 0;
+        }
+
+        std::atomic<uint64_t> s_[slots]{};
+    };
+} // namespace regbus
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // TriggeredCapture: oscilloscope-style pre/post-trigger capture of a set
+    // of Data keys.
+    //
+    // poll(reg, now_us) is called from the capture thread at the desired
+    // sample rate. It copies every watched key whose seq changed into that
+    // key's pre-trigger ring (Pre samples, oldest overwritten), then evaluates
+    // the triggers. Writers are never touched: capture costs them nothing.
+    //
+    // Triggers (up to MaxTriggers, any one fires):
+    //   - trigger_on_cmd<K>()         : Cmd key K was posted since the last poll
+    //                                   (even if already consumed); the first poll
+    //                                   after install or rearm() only takes the
+    //                                   baseline, so earlier posts never fire
+    //   - trigger_when<K>(pred)       : pred(value) is true for a new sample of Data key K
+    //   - fire(now_us)                : manual, e.g. from the command handler
+    //
+    // On trigger the pre rings freeze in O(1) (no copy) and new samples go to
+    // a preallocated post buffer (Post samples per key) until post_us elapsed
+    // or every post buffer is full. The capture then stays frozen until rearm().
+    template <typename Reg, std::size_t Pre, std::size_t Post, typename Reg::key_type... Watched>
+    class TriggeredCapture
+    {
+        using Key = typename Reg::key_type;
+        static constexpr std::size_t MaxTriggers = 4;
+
+        template <Key K>
+        struct Sample
+        {
+            uint64_t t;
+            typename Reg::template value_t<K> v;
+        };
+
+        template <Key K>
+        struct History
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "TriggeredCapture: watched keys must be Data keys");
+            std::array<Sample<K>, Pre> pre;
+            std::array<Sample<K>, Post> post;
+            uint32_t head;  // next pre slot
+            uint32_t count; // valid pre samples
+            uint32_t npost;
+            uint32_t last_seq;
+        };
+
+        using AnyFn = void (*)();
+        struct Trigger
+        {
+            bool (*check)(const Reg &, Trigger &);
+            AnyFn arg;
+            uint32_t state; // last seq / post count seen
+            bool cmd;       // Cmd trigger
+            bool resync;    // adopt the current state without firing
+        };
+
+    public:
+        enum class State : uint8_t
+        {
+            Armed,     // recording history, waiting for a trigger
+            Triggered, // pre window frozen, filling post buffers
+            Done       // capture complete; dump, then rearm()
+        };
+
+        TriggeredCapture(uint64_t pre_us, uint64_t post_us) : pre_us_(pre_us), post_us_(post_us) {}
+
+        template <Key K>
+        bool trigger_on_cmd()
+        {
+            static_assert(Reg::template kind<K> == Kind::Cmd, "trigger_on_cmd<K>: K must be a Cmd key");
+            return add({&check_cmd<K>, nullptr, 0, true, true}); // first poll records the baseline
+        }
+
+        template <Key K>
+        bool trigger_when(bool (*pred)(const typename Reg::template value_t<K> &))
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "trigger_when<K>: K must be a Data key");
+            return add({&check_pred<K>, reinterpret_cast<AnyFn>(pred), 0, false, false});
+        }
+
+        // Manual trigger (no-op unless armed)
+        void fire(uint64_t now_us)
+        {
+            if (state_ != State::Armed)
+                return;
+            state_ = State::Triggered;
+            t_trigger_ = now_us;
+        }
+
+        State poll(const Reg &reg, uint64_t now_us)
+        {
+            if (state_ == State::Done)
+                return state_;
+
+            bool full = true;
+            (sample<Watched>(reg, now_us, full), ...);
+
+            if (state_ == State::Armed)
+            {
+                for (std::size_t i = 0; i < ntrig_; ++i)
+                    if (trig_[i].check(reg, trig_[i]))
+                    {
+                        fire(now_us);
+                        break;
+                    }
+            }
+            else if (now_us - t_trigger_ >= post_us_ || full)
+            {
+                state_ = State::Done;
+            }
+            return state_;
+        }
+
+        // Clear history and buffers, keep triggers
+        void rearm()
+        {
+            (reset<Watched>(), ...);
+            for (std::size_t i = 0; i < ntrig_; ++i)
+                if (trig_[i].cmd)
+                    trig_[i].resync = true; // posts made while not armed do not fire
+            state_ = State::Armed;
+        }
+
+        State state() const { return state_; }
+        uint64_t trigger_time() const { return t_trigger_; }
+
+        // Calls f(t_us, const value_t<K> &) for the captured window of K in time
+        // order: pre samples within pre_us of the trigger, then post samples.
+        // While armed, visits the current pre-trigger history.
+        template <Key K, typename F>
+        std::size_t for_each(F &&f) const
+        {
+            const auto &h = hist<K>();
+            std::size_t n = 0;
+            for (uint32_t i = 0; i < h.count; ++i)
+            {
+                const auto &s = h.pre[(h.head + Pre - h.count + i) % Pre];
+                if (state_ != State::Armed && t_trigger_ - s.t > pre_us_)
+                    continue;
+                f(s.t, s.v);
+                ++n;
+            }
+            for (uint32_t i = 0; i < h.npost; ++i, ++n)
+                f(h.post[i].t, h.post[i].v);
+            return n;
+        }
+
+    private:
+        template <Key K>
+        static constexpr std::size_t slot()
+        {
+            std::size_t i = 0, found = sizeof...(Watched);
+            ((Watched == K ? (found = i, ++i) : ++i), ...);
+            return found;
+        }
+
+        template <Key K>
+        History<K> &hist()
+        {
+            static_assert(slot<K>() < sizeof...(Watched), "TriggeredCapture: key is not watched");
+            return std::get<slot<K>()>(hist_);
+        }
+        template <Key K>
+        const History<K> &hist() const
+        {
+            static_assert(slot<K>() < sizeof...(Watched), "TriggeredCapture: key is not watched");
+            return std::get<slot<K>()>(hist_);
+        }
+
+        template <Key K>
+        void sample(const Reg &reg, uint64_t now_us, bool &full)
+        {
+            auto &h = hist<K>();
+            if (state_ == State::Triggered && h.npost == Post)
+                return;
+            typename Reg::template value_t<K> v{};
+            uint32_t seq = 0;
+            if (reg.template read<K>(v, &seq) && seq != h.last_seq)
+            {
+                h.last_seq = seq;
+                if (state_ == State::Armed)
+                {
+                    h.pre[h.head] = {now_us, v};
+                    h.head = uint32_t((h.head + 1) % Pre);
+                    if (h.count < Pre)
+                        ++h.count;
+                }
+                else
+                {
+                    h.post[h.npost++] = {now_us, v};
+                }
+            }
+            if (state_ != State::Triggered || h.npost < Post)
+                full = false;
+        }
+
+        template <Key K>
+        void reset()
+        {
+            auto &h = hist<K>();
+            h.head = h.count = h.npost = 0;
+        }
+
+        bool add(const Trigger &t)
+        {
+            if (ntrig_ == MaxTriggers)
+                return false;
+            trig_[ntrig_++] = t;
+            return true;
+        }
+
+        // Any post since the last check, counted so a post consumed between
+        // two polls still fires
+        template <Key K>
+        static bool check_cmd(const Reg &reg, Trigger &t)
+        {
+            const uint32_t now = reg.template posts<K>();
+            const bool fired = now != t.state && !t.resync;
+            t.state = now;
+            t.resync = false;
+            return fired;
+        }
+
+        // Predicate on each new sample
+        template <Key K>
+        static bool check_pred(const Reg &reg, Trigger &t)
+        {
+            using T = typename Reg::template value_t<K>;
+            T v{};
+            uint32_t seq = 0;
+            if (!reg.template read<K>(v, &seq) || seq == t.state)
+                return false;
+            t.state = seq;
+            return reinterpret_cast<bool (*)(const T &)>(t.arg)(v);
+        }
+
+        uint64_t pre_us_;
+        uint64_t post_us_;
+        uint64_t t_trigger_ = 0;
+        State state_ = State::Armed;
+        std::array<Trigger, MaxTriggers> trig_{};
+        std::size_t ntrig_ = 0;
+        std::tuple<History<Watched>...> hist_{};
+    };
+} // namespace regbus
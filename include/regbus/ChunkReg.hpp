@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace regbus
+{
+    // ChunkReg<T, ChunkBytes>: single-slot register for very large payloads
+    // (maps, grids), split into ChunkBytes pieces that each carry their own
+    // seqlock sequence.
+    //
+    // Writer (single): write(v) publishes chunk by chunk, skipping chunks
+    // whose bytes did not change; write_bytes(off, src, n) updates a range
+    // (rejected, returning false, if it runs past the payload). Both count as
+    // a frame. Each chunk becomes visible as soon as it is copied.
+    // Readers keep a Cursor with the last sequence seen per chunk and
+    // read_changed() copies only chunks that moved since, so a mostly static
+    // 4 MB map costs a scan of the (compact) sequence array plus the few
+    // chunks that changed.
+    //
+    // Every chunk read is coherent; a read that overlaps a write may mix old
+    // and new chunks. read_frame() repeats the incremental read until no
+    // write() or write_bytes() overlapped it, for callers that need whole
+    // frames. Readers yield while the writer is inside a chunk or frame.
+    template <typename T, std::size_t ChunkBytes = 4096>
+    class ChunkReg
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "ChunkReg<T>: T must be trivially copyable (no heap, fast copy).");
+        static_assert(ChunkBytes >= 64 && ChunkBytes % 64 == 0, "ChunkReg: ChunkBytes must be a multiple of 64");
+
+    public:
+        static constexpr std::size_t chunk_bytes = ChunkBytes;
+        static constexpr std::size_t chunks = (sizeof(T) + ChunkBytes - 1) / ChunkBytes;
+
+        // Per-reader state: last sequence seen per chunk (0 = never)
+        struct Cursor
+        {
+            uint32_t seq[chunks]{};
+            uint32_t frame = 0; // frame() seen by the last read_frame()
+        };
+
+        inline void write(const T &v)
+        {
+            const unsigned char *src = reinterpret_cast<const unsigned char *>(&v);
+            frame_.fetch_add(1, std::memory_order_relaxed); // odd: frame in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                const std::size_t off = c * ChunkBytes, n = len(c);
+                if (seq_[c].load(std::memory_order_relaxed) != 0 && std::memcmp(bytes() + off, src + off, n) == 0)
+                    continue; // unchanged: readers keep their copy
+                publish(c, src + off, off, n);
+            }
+            frame_.fetch_add(1, std::memory_order_release);
+        }
+
+        // Update [off, off + n) of the payload; touches only covering chunks.
+        // False (nothing written) if the range runs past sizeof(T).
+        inline bool write_bytes(std::size_t off, const void *src, std::size_t n)
+        {
+            if (off > sizeof(T) || n > sizeof(T) - off)
+                return false;
+            const unsigned char *s = static_cast<const unsigned char *>(src);
+            frame_.fetch_add(1, std::memory_order_relaxed); // odd: frame in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            while (n)
+            {
+                const std::size_t c = off / ChunkBytes, in = off % ChunkBytes;
+                const std::size_t k = n < ChunkBytes - in ? n : ChunkBytes - in;
+                publish(c, s, off, k);
+                off += k;
+                s += k;
+                n -= k;
+            }
+            frame_.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        // Copies chunks changed since cur into out; returns chunks copied
+        inline std::size_t read_changed(T &out, Cursor &cur) const
+        {
+            unsigned char *dst = reinterpret_cast<unsigned char *>(&out);
+            std::size_t copied = 0;
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                for (;;)
+                {
+                    const uint32_t s1 = seq_[c].load(std::memory_order_acquire);
+                    if (s1 == cur.seq[c])
+                        break;
+                    if (s1 & 1u)
+                    {
+                        std::this_thread::yield(); // writer inside this chunk
+                        continue;
+                    }
+                    std::memcpy(dst + c * ChunkBytes, bytes() + c * ChunkBytes, len(c));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (seq_[c].load(std::memory_order_relaxed) == s1)
+                    {
+                        cur.seq[c] = s1;
+                        ++copied;
+                        break;
+                    }
+                }
+            }
+            return copied;
+        }
+
+        // Incremental read of one complete frame: repeats read_changed until
+        // no write() overlapped it. Returns chunks copied.
+        inline std::size_t read_frame(T &out, Cursor &cur) const
+        {
+            std::size_t copied = 0;
+            for (;;)
+            {
+                const uint32_t f0 = frame_.load(std::memory_order_acquire);
+                if (f0 & 1u)
+                {
+                    std::this_thread::yield(); // write in progress
+                    continue;
+                }
+                copied += read_changed(out, cur);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (frame_.load(std::memory_order_relaxed) == f0)
+                {
+                    cur.frame = f0 / 2;
+                    return copied;
+                }
+            }
+        }
+
+        // Completed write() / write_bytes() calls
+        inline uint32_t frame() const { return frame_.load(std::memory_order_acquire) / 2; }
+        inline uint32_t seq() const { return frame(); }
+        inline bool has() const { return frame() != 0; }
+
+    private:
+        static constexpr std::size_t len(std::size_t c)
+        {
+            return c + 1 < chunks ? ChunkBytes : sizeof(T) - c * ChunkBytes;
+        }
+
+        inline unsigned char *bytes() { return reinterpret_cast<unsigned char *>(&buf_); }
+        inline const unsigned char *bytes() const { return reinterpret_cast<const unsigned char *>(&buf_); }
+
+        inline void publish(std::size_t c, const unsigned char *src, std::size_t off, std::size_t n)
+        {
+            const uint32_t s = seq_[c].load(std::memory_order_relaxed);
+            seq_[c].store(s + 1, std::memory_order_relaxed); // odd: in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(bytes() + off, src, n);
+            seq_[c].store(s + 2 != 0 ? s + 2 : 2, std::memory_order_release); // 0 stays "never"
+        }
+
+        alignas(64) std::atomic<uint32_t> frame_{0}; // 2 per write / write_bytes, odd while writing
+        alignas(64) std::atomic<uint32_t> seq_[chunks]{}; // compact: change scan touches few lines
+        alignas(64) T buf_{};
+    };
+} // namespace regbus
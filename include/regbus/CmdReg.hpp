@@ -1,6 +1,9 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+
+#include "Futex.hpp"
 
 namespace regbus
 {
@@ -11,20 +14,85 @@ namespace regbus
         void post(const T &v)
         {
             val_ = v;
-            ready_.store(true, std::memory_order_release);
+            publish();
         }
-        bool consume(T &out)
+
+        // Same, with a tag (e.g. an audit seq) that travels with the value.
+        // Returns the tag of a command this post replaced before it was
+        // consumed, 0 if none.
+        uint64_t post(const T &v, uint64_t tag)
         {
-            if (!ready_.load(std::memory_order_acquire))
+            const uint64_t prev = tag_;
+            val_ = v;
+            tag_ = tag;
+            return publish() & ready_bit ? prev : 0;
+        }
+
+        bool consume(T &out, uint64_t *tag = nullptr)
+        {
+            if (!(ready_.load(std::memory_order_acquire) & ready_bit))
                 return false;
             out = val_;
-            ready_.store(false, std::memory_order_release);
+            if (tag)
+                *tag = tag_;
+            ready_.store(0, std::memory_order_release);
             return true;
         }
-        bool pending() const { return ready_.load(std::memory_order_acquire); }
+        bool pending() const { return ready_.load(std::memory_order_acquire) & ready_bit; }
+
+        // Posts so far (wraps); changes even if the command was consumed since
+        uint32_t posts() const { return posts_.load(std::memory_order_acquire); }
+
+        // Level, not count: published is 1 while a command is pending
+        WaitStamp stamp() const
+        {
+            const uint32_t p = ready_.load(std::memory_order_seq_cst) & ready_bit;
+            return {p, p};
+        }
+
+        // Blocks until a command arrives (true) or timeout_us passes (false;
+        // 0 = wait forever). Parks on the ready word instead of polling.
+        bool consume_wait(T &out, uint64_t timeout_us = 0, uint64_t *tag = nullptr)
+        {
+            const uint64_t deadline = timeout_us ? detail::steady_us() + timeout_us : 0;
+            for (;;)
+            {
+                if (consume(out, tag))
+                    return true;
+                uint64_t left = 0;
+                if (deadline)
+                {
+                    const uint64_t now = detail::steady_us();
+                    if (now >= deadline)
+                        return false;
+                    left = deadline - now;
+                }
+                // Announce the waiter; post() sees the bit and wakes
+                uint32_t s = ready_.load(std::memory_order_acquire);
+                if (s & ready_bit)
+                    continue;
+                if (!(s & parked_bit) && !ready_.compare_exchange_weak(s, s | parked_bit, std::memory_order_acq_rel))
+                    continue;
+                futex_wait(ready_, parked_bit, left);
+            }
+        }
 
     private:
+        static constexpr uint32_t ready_bit = 1, parked_bit = 2;
+
+        // One RMW: also tells us whether a consume_wait() is parked
+        uint32_t publish()
+        {
+            posts_.store(posts_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // posts are serialized
+            const uint32_t old = ready_.exchange(ready_bit, std::memory_order_seq_cst);
+            if (old & parked_bit)
+                futex_wake_all(ready_);
+            return old;
+        }
+
         T val_{};
-        std::atomic<bool> ready_{false};
+        uint64_t tag_ = 0; // written and read with val_
+        std::atomic<uint32_t> ready_{0}; // ready_bit | parked_bit
+        std::atomic<uint32_t> posts_{0};
     };
 } // namespace regbus
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+#include "Fields.hpp"
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // ColumnarExporter: turns a stream of (key, timestamp, value) samples into
+    // a columnar file for offline analysis (e.g. numpy.frombuffer per column).
+    //
+    // Samples are staged per key in fixed chunks of Rows rows; when a chunk
+    // fills (or on finish()) it is transposed and written as one contiguous
+    // column per field. Memory is bounded by Rows * (8 + sizeof(T)) per key
+    // plus a small scratch buffer; nothing is allocated.
+    //
+    // Field layout comes from Traits (see Fields.hpp):
+    //   static constexpr regbus::Field fields[] = {REGBUS_FIELD(IMURaw, t_us), ...};
+    // Keys without `fields` are exported as a single "value" column.
+    //
+    // File layout (little-endian host order):
+    //   header : "RBCOLv1\0", u32 key count, then per Data key:
+    //            u16 key index, u16 field count, u32 value size, then per field:
+    //            u8 FieldType, u8 0, u16 name length, u32 offset, u32 size, name
+    //   chunks : u32 'CHNK', u16 key index, u16 0, u32 rows,
+    //            u64 timestamps[rows], then each field column (size * rows bytes)
+    //
+    // Sink is any callable sink(const uint8_t *data, std::size_t n).
+    template <typename Reg, typename Sink, std::size_t Rows = 1024>
+    class ColumnarExporter
+    {
+        using Key = typename Reg::key_type;
+
+        template <Key K>
+        struct DataStage
+        {
+            std::array<uint64_t, Rows> t;
+            std::array<typename Reg::template value_t<K>, Rows> v;
+            uint32_t n;
+            uint32_t last_seq;
+        };
+        struct NoStage
+        {
+        };
+        template <Key K>
+        using Stage = std::conditional_t<Reg::template kind<K> == Kind::Data, DataStage<K>, NoStage>;
+
+    public:
+        static constexpr uint32_t chunk_magic = 0x4B4E4843u; // "CHNK"
+
+        explicit ColumnarExporter(Sink sink) : sink_(sink) {}
+        ~ColumnarExporter() { finish(); }
+
+        ColumnarExporter(const ColumnarExporter &) = delete;
+        ColumnarExporter &operator=(const ColumnarExporter &) = delete;
+
+        // Append one sample of Data key K
+        template <Key K>
+        void append(uint64_t t_us, const typename Reg::template value_t<K> &v)
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "ColumnarExporter: K must be a Data key");
+            auto &s = std::get<Reg::template index<K>()>(stages_);
+            s.t[s.n] = t_us;
+            s.v[s.n] = v;
+            if (++s.n == Rows)
+                flush<K>();
+        }
+
+        // Record every Data key whose seq changed since the last capture,
+        // stamped with now_us (coherent snapshot per key)
+        std::size_t capture(const Reg &reg, uint64_t now_us)
+        {
+            std::size_t n = 0;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    auto &s = std::get<Reg::template index<K>()>(stages_);
+                    typename Reg::template value_t<K> v{};
+                    uint32_t seq = 0;
+                    if (reg.template read<K>(v, &seq) && seq != s.last_seq)
+                    {
+                        s.last_seq = seq;
+                        append<K>(now_us, v);
+                        ++n;
+                    }
+                } });
+            return n;
+        }
+
+        // Flush all partial chunks (writes the header if nothing was written yet)
+        void finish()
+        {
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                    flush<K>(); });
+            header();
+        }
+
+    private:
+        void put(const void *p, std::size_t n)
+        {
+            sink_(static_cast<const uint8_t *>(p), n);
+        }
+        template <typename U>
+        void put_pod(U v) { put(&v, sizeof(v)); }
+
+        void header()
+        {
+            if (header_done_)
+                return;
+            header_done_ = true;
+            put("RBCOLv1\0", 8);
+            uint32_t keys = 0;
+            Reg::for_each_key([&](auto key)
+                              { keys += Reg::template kind<decltype(key)::value> == Kind::Data; });
+            put_pod(keys);
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    using F = fields_of<typename Reg::template traits_t<K>>;
+                    put_pod(uint16_t(Reg::template index<K>()));
+                    put_pod(uint16_t(F::count()));
+                    put_pod(uint32_t(sizeof(typename Reg::template value_t<K>)));
+                    for (std::size_t i = 0; i < F::count(); ++i)
+                    {
+                        const Field f = F::at(i);
+                        const uint16_t len = uint16_t(std::strlen(f.name));
+                        put_pod(uint8_t(f.type));
+                        put_pod(uint8_t(0));
+                        put_pod(len);
+                        put_pod(f.offset);
+                        put_pod(f.size);
+                        put(f.name, len);
+                    }
+                } });
+        }
+
+        template <Key K>
+        void flush()
+        {
+            using F = fields_of<typename Reg::template traits_t<K>>;
+            static_assert(F::valid(), "ColumnarExporter: Traits::fields exceed the value size");
+            auto &s = std::get<Reg::template index<K>()>(stages_);
+            if (!s.n)
+                return;
+            header();
+            put_pod(chunk_magic);
+            put_pod(uint16_t(Reg::template index<K>()));
+            put_pod(uint16_t(0));
+            put_pod(s.n);
+            put(s.t.data(), s.n * sizeof(uint64_t));
+
+            // Transpose field by field through the scratch buffer
+            for (std::size_t i = 0; i < F::count(); ++i)
+            {
+                const Field f = F::at(i);
+                std::size_t w = 0;
+                for (uint32_t r = 0; r < s.n; ++r)
+                {
+                    const uint8_t *src = reinterpret_cast<const uint8_t *>(&s.v[r]) + f.offset;
+                    for (std::size_t done = 0; done < f.size;)
+                    {
+                        std::size_t c = f.size - done;
+                        if (c > scratch_.size() - w)
+                            c = scratch_.size() - w;
+                        std::memcpy(scratch_.data() + w, src + done, c);
+                        w += c;
+                        done += c;
+                        if (w == scratch_.size())
+                        {
+                            put(scratch_.data(), w);
+                            w = 0;
+                        }
+                    }
+                }
+                if (w)
+                    put(scratch_.data(), w);
+            }
+            s.n = 0;
+        }
+
+        Sink sink_;
+        bool header_done_ = false;
+        typename Reg::template per_key_t<Stage> stages_{};
+        std::array<uint8_t, 4096> scratch_{};
+    };
+} // namespace regbus
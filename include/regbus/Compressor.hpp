@@ -0,0 +1,600 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Registry.hpp"
+#include "SpscRing.hpp"
+
+namespace regbus
+{
+    // Gorilla-style compression of recorded register streams.
+    //
+    // Every sample (key, t_us, value) is encoded against the previous sample
+    // of the same key:
+    //   - key index in the fewest bits that hold Reg::size(),
+    //   - timestamp as delta-of-delta: '0' | '10'+7b | '110'+9b | '1110'+12b | '1111'+64b,
+    //   - value as 32-bit words XORed with the previous value: '0' if equal,
+    //     else '1' then either '0' + bits inside the previous leading/trailing
+    //     zero window or '1' + 5b leading zeros + 5b (length-1) + bits.
+    // Floats compress well word-wise; integers that drift slowly do too.
+    //
+    // Output is a sequence of independently decodable blocks:
+    //   u32 'RBXZ', u32 payload bytes, u32 sample count, payload (bit stream)
+    // Per-key state is reset at each block start, so a damaged block only
+    // loses itself and replay can seek at block granularity: the decoder
+    // decodes a block once into a scratch buffer, checking field ranges and
+    // reads past its end, and delivers its samples only if that succeeded.
+    namespace detail
+    {
+        inline unsigned clz32(uint32_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return x ? unsigned(__builtin_clz(x)) : 32u;
+#else
+            unsigned n = 0;
+            for (uint32_t m = 0x80000000u; m && !(x & m); m >>= 1)
+                ++n;
+            return n;
+#endif
+        }
+        inline unsigned ctz32(uint32_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return x ? unsigned(__builtin_ctz(x)) : 32u;
+#else
+            unsigned n = 0;
+            for (uint32_t m = 1; m && !(x & m); m <<= 1)
+                ++n;
+            return n;
+#endif
+        }
+
+        // MSB-first bit writer over a caller buffer
+        class BitWriter
+        {
+        public:
+            void reset(uint8_t *buf) { buf_ = buf, pos_ = 0, acc_ = 0, nacc_ = 0; }
+
+            inline void put(uint64_t v, unsigned n)
+            {
+                if (n > 32)
+                {
+                    put(v >> 32, n - 32);
+                    v &= 0xFFFFFFFFu;
+                    n = 32;
+                }
+                acc_ = (acc_ << n) | (v & ((uint64_t(1) << n) - 1));
+                nacc_ += n;
+                while (nacc_ >= 8)
+                {
+                    nacc_ -= 8;
+                    buf_[pos_++] = uint8_t(acc_ >> nacc_);
+                }
+                acc_ &= (uint64_t(1) << nacc_) - 1;
+            }
+
+            // Pad to a byte boundary; returns bytes written
+            std::size_t finish()
+            {
+                if (nacc_)
+                    put(0, 8 - nacc_);
+                return pos_;
+            }
+            std::size_t bits() const { return pos_ * 8 + nacc_; }
+
+        private:
+            uint8_t *buf_ = nullptr;
+            std::size_t pos_ = 0;
+            uint64_t acc_ = 0;
+            unsigned nacc_ = 0;
+        };
+
+        // MSB-first bit reader; reads past the end return zeros and set overrun()
+        class BitReader
+        {
+        public:
+            BitReader(const uint8_t *p, std::size_t n) : p_(p), end_(p + n) {}
+
+            inline uint64_t get(unsigned n)
+            {
+                if (n > 32)
+                {
+                    uint64_t hi = get(n - 32);
+                    return (hi << 32) | get(32);
+                }
+                while (nacc_ < n)
+                {
+                    if (p_ < end_)
+                        acc_ = (acc_ << 8) | *p_++;
+                    else
+                        acc_ <<= 8, ++pad_;
+                    nacc_ += 8;
+                }
+                nacc_ -= n;
+                uint64_t v = (acc_ >> nacc_) & ((uint64_t(1) << n) - 1);
+                acc_ &= (uint64_t(1) << nacc_) - 1;
+                return v;
+            }
+            inline bool bit() { return get(1) != 0; }
+
+            // Some bit returned so far came from past the end
+            inline bool overrun() const { return pad_ * 8 > nacc_; }
+
+        private:
+            const uint8_t *p_;
+            const uint8_t *end_;
+            uint64_t acc_ = 0;
+            unsigned nacc_ = 0;
+            std::size_t pad_ = 0; // zero bytes fed past the end
+        };
+
+        // Per-Registry sizes shared by encoder and decoder
+        template <typename Reg>
+        struct xor_layout
+        {
+            static constexpr std::size_t max_bytes()
+            {
+                std::size_t m = 0;
+                Reg::for_each_key([&](auto key)
+                                  {
+                    constexpr auto K = decltype(key)::value;
+                    if constexpr (Reg::template kind<K> == Kind::Data)
+                        if (sizeof(typename Reg::template value_t<K>) > m)
+                            m = sizeof(typename Reg::template value_t<K>); });
+                return m;
+            }
+            static constexpr std::size_t max_words = (max_bytes() + 3) / 4;
+            // Decoded / queued sample: t, key, then the value in 8-byte words
+            static constexpr std::size_t head_words = 2;
+            static constexpr std::size_t words64(std::size_t bytes) { return (bytes + 7) / 8; }
+            static constexpr unsigned key_bits()
+            {
+                unsigned b = 1;
+                while ((std::size_t(1) << b) < Reg::size())
+                    ++b;
+                return b;
+            }
+            // Worst-case encoded sample, in bits
+            static constexpr std::size_t max_sample_bits = key_bits() + 4 + 64 + max_words * (2 + 5 + 5 + 32);
+
+            std::array<uint32_t, Reg::size()> bytes{};
+            xor_layout()
+            {
+                Reg::for_each_key([&](auto key)
+                                  {
+                    constexpr auto K = decltype(key)::value;
+                    if constexpr (Reg::template kind<K> == Kind::Data)
+                        bytes[Reg::template index<K>()] = uint32_t(sizeof(typename Reg::template value_t<K>)); });
+            }
+        };
+
+        struct xor_key_state
+        {
+            uint32_t count; // samples of this key in the current block
+            uint64_t t;
+            int64_t delta;
+        };
+    } // namespace detail
+
+    // Encoder: call begin(buf) with a buffer of at least BlockBytes + 12,
+    // encode() samples while fits() and end() to get the block size.
+    template <typename Reg, std::size_t BlockBytes = 64 * 1024>
+    class XorEncoder
+    {
+        using L = detail::xor_layout<Reg>;
+        static constexpr std::size_t W = L::max_words;
+
+    public:
+        static constexpr std::size_t header_bytes = 12;
+        static constexpr uint32_t magic = 0x5A584252u; // "RBXZ"
+        static_assert(BlockBytes * 8 >= 2 * L::max_sample_bits, "XorEncoder: BlockBytes too small");
+
+        void begin(uint8_t *block)
+        {
+            block_ = block;
+            bw_.reset(block + header_bytes);
+            samples_ = 0;
+            for (auto &s : state_)
+                s.count = 0;
+        }
+
+        bool fits() const { return bw_.bits() + L::max_sample_bits <= BlockBytes * 8; }
+        uint32_t samples() const { return samples_; }
+
+        // bytes must hold layout_.bytes[key] bytes
+        void encode(std::size_t key, uint64_t t, const uint8_t *bytes)
+        {
+            detail::xor_key_state &s = state_[key];
+            bw_.put(key, L::key_bits());
+
+            // Timestamp
+            if (s.count == 0)
+            {
+                bw_.put(t, 64);
+                s.delta = 0;
+            }
+            else
+            {
+                const int64_t d = int64_t(t - s.t);
+                const int64_t dod = d - s.delta;
+                if (dod == 0)
+                    bw_.put(0, 1);
+                else if (dod >= -64 && dod <= 63)
+                    bw_.put(0x2, 2), bw_.put(uint64_t(dod), 7);
+                else if (dod >= -256 && dod <= 255)
+                    bw_.put(0x6, 3), bw_.put(uint64_t(dod), 9);
+                else if (dod >= -2048 && dod <= 2047)
+                    bw_.put(0xE, 4), bw_.put(uint64_t(dod), 12);
+                else
+                    bw_.put(0xF, 4), bw_.put(uint64_t(dod), 64);
+                s.delta = d;
+            }
+            s.t = t;
+
+            // Value words
+            const uint32_t n = layout_.bytes[key];
+            uint32_t *prev = prev_[key].data();
+            uint8_t *lead = lead_[key].data();
+            uint8_t *trail = trail_[key].data();
+            for (uint32_t w = 0; w * 4 < n; ++w)
+            {
+                uint32_t cur = 0;
+                std::memcpy(&cur, bytes + w * 4, n - w * 4 >= 4 ? 4 : n - w * 4);
+                const uint32_t x = s.count ? cur ^ prev[w] : cur;
+                prev[w] = cur;
+                if (s.count == 0)
+                    lead[w] = 0xFF; // no window yet
+                if (x == 0)
+                {
+                    bw_.put(0, 1);
+                    continue;
+                }
+                const unsigned lz = detail::clz32(x), tz = detail::ctz32(x);
+                if (lead[w] != 0xFF && lz >= lead[w] && tz >= trail[w])
+                {
+                    bw_.put(0x2, 2);
+                    bw_.put(x >> trail[w], 32 - lead[w] - trail[w]);
+                }
+                else
+                {
+                    const unsigned len = 32 - lz - tz;
+                    bw_.put(0x3, 2);
+                    bw_.put(lz, 5);
+                    bw_.put(len - 1, 5);
+                    bw_.put(x >> tz, len);
+                    lead[w] = uint8_t(lz);
+                    trail[w] = uint8_t(tz);
+                }
+            }
+            ++s.count;
+            ++samples_;
+        }
+
+        // Finish the block; returns its total size including the header
+        std::size_t end()
+        {
+            const std::size_t payload = bw_.finish();
+            const uint32_t hdr[3] = {magic, uint32_t(payload), samples_};
+            std::memcpy(block_, hdr, sizeof(hdr));
+            return header_bytes + payload;
+        }
+
+        const L &layout() const { return layout_; }
+
+    private:
+        L layout_;
+        uint8_t *block_ = nullptr;
+        detail::BitWriter bw_;
+        uint32_t samples_ = 0;
+        std::array<detail::xor_key_state, Reg::size()> state_{};
+        std::array<std::array<uint32_t, W>, Reg::size()> prev_{};
+        std::array<std::array<uint8_t, W>, Reg::size()> lead_{};
+        std::array<std::array<uint8_t, W>, Reg::size()> trail_{};
+    };
+
+    // Decoder: decode_block() calls f(key_index, t_us, const uint8_t *bytes)
+    // for every sample; bytes holds the key's value (memcpy into value_t<K>).
+    template <typename Reg>
+    class XorDecoder
+    {
+        using L = detail::xor_layout<Reg>;
+        static constexpr std::size_t W = L::max_words;
+
+    public:
+        // Returns bytes consumed (0 on a bad/short header: no block here).
+        // A block whose payload is corrupt delivers no samples; *ok (optional)
+        // is false and its bytes are still consumed so decoding can go on.
+        template <typename F>
+        std::size_t decode_block(const uint8_t *p, std::size_t n, F &&f, bool *ok = nullptr)
+        {
+            uint32_t hdr[3];
+            if (n < sizeof(hdr))
+                return 0;
+            std::memcpy(hdr, p, sizeof(hdr));
+            if (hdr[0] != XorEncoder<Reg>::magic || n - sizeof(hdr) < hdr[1])
+                return 0;
+
+            // One pass into scratch_, then deliver: a damaged block emits nothing
+            scratch_.clear();
+            const bool good = run(p + sizeof(hdr), hdr[1], hdr[2]);
+            if (good)
+                for (std::size_t i = 0; i < scratch_.size();)
+                {
+                    const std::size_t key = std::size_t(scratch_[i + 1]);
+                    f(key, scratch_[i], reinterpret_cast<const uint8_t *>(&scratch_[i + L::head_words]));
+                    i += L::head_words + L::words64(layout_.bytes[key]);
+                }
+            if (ok)
+                *ok = good;
+            return sizeof(hdr) + hdr[1];
+        }
+
+        // Decode a whole stream of blocks, skipping corrupt ones (counted in
+        // *bad, optional); returns samples decoded
+        template <typename F>
+        std::size_t decode(const uint8_t *p, std::size_t n, F &&f, std::size_t *bad = nullptr)
+        {
+            std::size_t samples = 0, off = 0;
+            while (off < n)
+            {
+                bool ok = true;
+                std::size_t used = decode_block(p + off, n - off, [&](std::size_t k, uint64_t t, const uint8_t *b)
+                                                { ++samples, f(k, t, b); },
+                                                &ok);
+                if (!used)
+                    break;
+                if (!ok && bad)
+                    ++*bad;
+                off += used;
+            }
+            return samples;
+        }
+
+    private:
+        // Decodes a block payload into scratch_; false on a field out of
+        // range or a read past the end
+        bool run(const uint8_t *payload, std::size_t bytes, uint32_t count)
+        {
+            detail::BitReader br(payload, bytes);
+            for (auto &s : state_)
+                s.count = 0;
+
+            alignas(8) uint8_t val[W * 4];
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const std::size_t key = std::size_t(br.get(L::key_bits()));
+                if (key >= Reg::size() || !layout_.bytes[key])
+                    return false;
+                detail::xor_key_state &s = state_[key];
+
+                if (s.count == 0)
+                {
+                    s.t = br.get(64);
+                    s.delta = 0;
+                }
+                else
+                {
+                    int64_t dod = 0;
+                    if (br.bit())
+                    {
+                        if (!br.bit())
+                            dod = sext(br.get(7), 7);
+                        else if (!br.bit())
+                            dod = sext(br.get(9), 9);
+                        else if (!br.bit())
+                            dod = sext(br.get(12), 12);
+                        else
+                            dod = int64_t(br.get(64));
+                    }
+                    s.delta += dod;
+                    s.t += uint64_t(s.delta);
+                }
+
+                const uint32_t nb = layout_.bytes[key];
+                uint32_t *prev = prev_[key].data();
+                uint8_t *lead = lead_[key].data();
+                uint8_t *trail = trail_[key].data();
+                for (uint32_t w = 0; w * 4 < nb; ++w)
+                {
+                    if (s.count == 0)
+                    {
+                        prev[w] = 0;
+                        lead[w] = 0xFF; // no window yet
+                    }
+                    uint32_t x = 0;
+                    if (br.bit())
+                    {
+                        if (!br.bit())
+                        {
+                            if (lead[w] == 0xFF)
+                                return false; // window reused before one was set
+                            x = uint32_t(br.get(32 - lead[w] - trail[w])) << trail[w];
+                        }
+                        else
+                        {
+                            const unsigned lz = unsigned(br.get(5));
+                            const unsigned len = unsigned(br.get(5)) + 1;
+                            if (lz + len > 32)
+                                return false;
+                            lead[w] = uint8_t(lz);
+                            trail[w] = uint8_t(32 - lz - len);
+                            x = uint32_t(br.get(len)) << trail[w];
+                        }
+                    }
+                    prev[w] ^= x;
+                    std::memcpy(val + w * 4, &prev[w], 4);
+                }
+                if (br.overrun())
+                    return false;
+                ++s.count;
+                const std::size_t at = scratch_.size();
+                scratch_.resize(at + L::head_words + L::words64(nb));
+                scratch_[at] = s.t;
+                scratch_[at + 1] = key;
+                std::memcpy(&scratch_[at + L::head_words], val, nb);
+            }
+            return true;
+        }
+
+        static int64_t sext(uint64_t v, unsigned bits)
+        {
+            const uint64_t m = uint64_t(1) << (bits - 1);
+            return int64_t((v ^ m) - m);
+        }
+
+        L layout_;
+        std::array<detail::xor_key_state, Reg::size()> state_{};
+        std::array<std::array<uint32_t, W>, Reg::size()> prev_{};
+        std::array<std::array<uint8_t, W>, Reg::size()> lead_{};
+        std::array<std::array<uint8_t, W>, Reg::size()> trail_{};
+        std::vector<uint64_t> scratch_; // kept across blocks: no allocation once grown
+    };
+
+    // CompressingRecorder: record()/capture() copy samples into a lock-free
+    // SPSC ring (never blocking, drops counted when full); a background thread
+    // drains the ring, XOR-encodes and hands finished blocks to
+    // sink(const uint8_t *data, std::size_t n). Register writers are not
+    // involved at all: only the recording thread touches the ring.
+    //
+    // The ring holds RingWords 8-byte words; a sample takes 2 + ceil(size of
+    // its value / 8) of them, so small keys are not padded to the largest.
+    template <typename Reg, typename Sink, std::size_t RingWords = 8192, std::size_t BlockBytes = 64 * 1024>
+    class CompressingRecorder
+    {
+        using L = detail::xor_layout<Reg>;
+        using Key = typename Reg::key_type;
+        static constexpr std::size_t max_record_words = L::head_words + L::words64(L::max_bytes());
+        static_assert(RingWords >= max_record_words, "CompressingRecorder: RingWords too small for the largest key");
+
+    public:
+        explicit CompressingRecorder(Sink sink) : sink_(sink) {}
+        ~CompressingRecorder() { stop(); }
+
+        CompressingRecorder(const CompressingRecorder &) = delete;
+        CompressingRecorder &operator=(const CompressingRecorder &) = delete;
+
+        void start()
+        {
+            if (worker_.joinable())
+                return;
+            run_.store(true, std::memory_order_release);
+            worker_ = std::thread([this]
+                                  { drain(); });
+        }
+
+        // Drain whatever is queued, flush the last block, join the thread
+        void stop()
+        {
+            if (!worker_.joinable())
+                return;
+            run_.store(false, std::memory_order_release);
+            worker_.join();
+        }
+
+        // Producer side (one thread). Returns false if the ring was full.
+        template <Key K>
+        bool record(uint64_t t_us, const typename Reg::template value_t<K> &v)
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "CompressingRecorder: K must be a Data key");
+            constexpr std::size_t n = L::head_words + L::words64(sizeof(v));
+            uint64_t w[n]{};
+            w[0] = t_us;
+            w[1] = Reg::template index<K>();
+            std::memcpy(&w[L::head_words], &v, sizeof(v));
+            if (ring_.try_push(w, n))
+                return true;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Record every Data key whose seq changed since the last capture
+        // (with Options<Key>::config: only keys the config has recorded())
+        std::size_t capture(const Reg &reg, uint64_t now_us)
+        {
+            const typename Reg::config_reader_t::Scope scope(config_, reg);
+            const typename Reg::config_t *cfg = scope.get();
+            std::size_t n = 0;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    constexpr std::size_t i = Reg::template index<K>();
+                    if (cfg && !cfg->recorded(i))
+                        return;
+                    typename Reg::template value_t<K> v{};
+                    uint32_t seq = 0;
+                    if (reg.template read<K>(v, &seq) && seq != last_seq_[i] && record<K>(now_us, v))
+                    {
+                        last_seq_[i] = seq; // a dropped sample is retried next capture
+                        ++n;
+                    }
+                } });
+            return n;
+        }
+
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        uint64_t samples() const { return samples_.load(std::memory_order_relaxed); }
+        uint64_t bytes_out() const { return bytes_out_.load(std::memory_order_relaxed); }
+
+    private:
+        void drain()
+        {
+            enc_.begin(block_.data());
+            uint64_t w[max_record_words];
+            for (;;)
+            {
+                const bool running = run_.load(std::memory_order_acquire);
+                bool any = false;
+                while (ring_.try_pop(w, L::head_words))
+                {
+                    // The value was published with its head
+                    const std::size_t key = std::size_t(w[1]);
+                    ring_.try_pop(&w[L::head_words], L::words64(enc_.layout().bytes[key]));
+                    any = true;
+                    if (!enc_.fits())
+                        flush();
+                    enc_.encode(key, w[0], reinterpret_cast<const uint8_t *>(&w[L::head_words]));
+                    samples_.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (!running)
+                    break;
+                if (!any)
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            flush();
+        }
+
+        void flush()
+        {
+            if (enc_.samples())
+            {
+                const std::size_t n = enc_.end();
+                sink_(static_cast<const uint8_t *>(block_.data()), n);
+                bytes_out_.fetch_add(n, std::memory_order_relaxed);
+            }
+            enc_.begin(block_.data());
+        }
+
+        Sink sink_;
+        SpscRing<uint64_t, RingWords> ring_;
+        std::array<uint32_t, Reg::size()> last_seq_{};
+        typename Reg::config_reader_t config_{};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> samples_{0};
+        std::atomic<uint64_t> bytes_out_{0};
+        std::atomic<bool> run_{false};
+        std::thread worker_;
+
+        // Worker-only state
+        XorEncoder<Reg, BlockBytes> enc_;
+        std::array<uint8_t, BlockBytes + XorEncoder<Reg, BlockBytes>::header_bytes> block_{};
+    };
+} // namespace regbus
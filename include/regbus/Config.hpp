@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "Epoch.hpp"
+
+namespace regbus
+{
+    // RegistryConfig<N>: runtime policy per key (by Registry::index<K>()) for
+    // the components around a registry. Default-constructed it changes
+    // nothing: every key bridged and recorded, Traits rate limits.
+    //   bridged(i)     — sync_newer() and Packer send key i
+    //   recorded(i)    — CompressingRecorder::capture() records key i
+    //   max_rate_hz[i] — Packer rate limit override (0 = Traits<K>::max_rate_hz;
+    //                    clamped so it never goes below Traits<K>::min_rate_hz)
+    template <std::size_t N>
+    struct RegistryConfig
+    {
+        static constexpr std::size_t words = (N + 63) / 64;
+
+        std::array<uint64_t, words> bridge_off{}; // set bit = excluded
+        std::array<uint64_t, words> record_off{};
+        std::array<uint32_t, N> max_rate_hz{};
+        uint64_t version = 0; // bumped by every update
+
+        inline bool bridged(std::size_t i) const { return !((bridge_off[i / 64] >> (i % 64)) & 1u); }
+        inline bool recorded(std::size_t i) const { return !((record_off[i / 64] >> (i % 64)) & 1u); }
+        inline void bridge(std::size_t i, bool on) { put(bridge_off, i, !on); }
+        inline void record(std::size_t i, bool on) { put(record_off, i, !on); }
+
+    private:
+        static void put(std::array<uint64_t, words> &w, std::size_t i, bool bit)
+        {
+            const uint64_t m = uint64_t(1) << (i % 64);
+            w[i / 64] = bit ? w[i / 64] | m : w[i / 64] & ~m;
+        }
+    };
+
+    template <typename Block>
+    class ConfigReader;
+
+    // ConfigBlock<N, Readers>: double-buffered RegistryConfig. The live
+    // buffer is picked by the parity of the block's epoch, so one swap is one
+    // epoch advance and readers (ConfigReader) take the config with one
+    // acquire load. Readers never wait; register writers are not involved.
+    //
+    // An update copies the live buffer into the spare one, applies the edit
+    // and advances. The spare buffer was live at the epoch before, so it is
+    // reused only once no reader still announces that epoch (EpochDomain);
+    // updates are rare and readers have normally moved on long ago.
+    template <std::size_t N, std::size_t Readers = 16>
+    class ConfigBlock
+    {
+    public:
+        using config_t = RegistryConfig<N>;
+        using reader_t = ConfigReader<ConfigBlock>;
+
+        // Applies edit(config_t &) to a copy of the live config and publishes
+        // it. Waits up to timeout_us (0 = forever) for readers of the config
+        // before last; false on timeout, nothing published.
+        template <typename F>
+        bool update(F &&edit, uint64_t timeout_us = 0) { return apply(edit, true, timeout_us); }
+
+        // Same, but never waits: false while the spare buffer may be in use
+        template <typename F>
+        bool try_update(F &&edit) { return apply(edit, false, 0); }
+
+        // Unsynchronized peek (tests, diagnostics); readers use ConfigReader
+        inline uint64_t version() const { return live(dom_.epoch()).version; }
+
+        // Readers turned away because every reader slot was taken, counted
+        // once per reader until it gets a slot (raise Readers /
+        // Options<Key>::config_readers if nonzero)
+        inline uint64_t refused() const { return refused_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class ConfigReader<ConfigBlock>;
+
+        inline const config_t &live(uint64_t epoch) const { return buf_[epoch & 1u]; }
+
+        template <typename F>
+        bool apply(F &edit, bool wait, uint64_t timeout_us)
+        {
+            struct Guard
+            {
+                std::atomic_flag &f;
+                explicit Guard(std::atomic_flag &fl) : f(fl)
+                {
+                    while (f.test_and_set(std::memory_order_acquire))
+                        std::this_thread::yield();
+                }
+                ~Guard() { f.clear(std::memory_order_release); }
+            } g(lock_);
+
+            // Readers still announcing an older epoch may hold the spare
+            const uint64_t e = dom_.epoch();
+            if (wait ? !dom_.wait(e, timeout_us) : !dom_.quiesced(e))
+                return false;
+            config_t &next = buf_[(e + 1) & 1u];
+            next = buf_[e & 1u];
+            edit(next);
+            next.version = buf_[e & 1u].version + 1;
+            dom_.advance(); // publishes next
+            return true;
+        }
+
+        config_t buf_[2]{};
+
+        // Reader bookkeeping: readers hold a const block (reading the config
+        // does not change it), but announce themselves here
+        mutable EpochDomain<Readers> dom_;
+        mutable std::atomic<uint64_t> refused_{0};
+
+        // Updater-only state
+        std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+    };
+
+    // ConfigReader: one consumer's view of a ConfigBlock (a Packer, a recorder,
+    // one bridge peer). enter() returns the live config; the reader keeps
+    // announcing the epoch of the config it last took until it enters again
+    // and sees a newer one, so the config stays valid across cycles and an
+    // update waits only for consumers that have not cycled since the swap
+    // before. A consumer about to go idle calls leave() so it holds up
+    // nothing. Scope enters for one cycle. Registers lazily on first enter();
+    // while all of the block's Readers slots are taken, enter() returns
+    // nullptr (see Block::refused()) and retries next time. Copies start
+    // unregistered.
+    //
+    // enter() is one acquire load of the epoch while the config is unchanged.
+    // After a swap (or leave()) it announces the new epoch once: one store
+    // and a seq_cst fence, so a concurrent update either sees the reader or
+    // the reader sees its epoch. Retrying without a slot is one relaxed load.
+    template <typename Block>
+    class ConfigReader
+    {
+    public:
+        using config_t = typename Block::config_t;
+
+        class Scope
+        {
+        public:
+            template <typename Reg>
+            Scope(ConfigReader &r, const Reg &reg) : cfg_(r.enter(reg.config_block())) {}
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+            // Live config, or nullptr if the reader has no slot
+            const config_t *get() const { return cfg_; }
+
+        private:
+            const config_t *cfg_;
+        };
+
+        ConfigReader() = default;
+        ConfigReader(const ConfigReader &) {}
+        ConfigReader &operator=(const ConfigReader &)
+        {
+            release();
+            return *this;
+        }
+        ~ConfigReader() { release(); }
+
+        // nullptr when no reader slot is free; leave() is still safe to call
+        inline const config_t *enter(const Block &b)
+        {
+            const uint64_t e = b.dom_.epoch();
+            if (b_ == &b && e == seen_)
+                return &b.live(e);
+            return announce(b);
+        }
+
+        // Stops announcing: updates no longer wait for this reader. The
+        // config from the last enter() must not be used after this.
+        inline void leave()
+        {
+            if (b_)
+                b_->dom_.offline(id_);
+            seen_ = 0;
+        }
+
+        // Holds a reader slot on some block
+        inline bool attached() const { return b_ != nullptr; }
+
+    private:
+        const config_t *announce(const Block &b)
+        {
+            if (b_ != &b)
+            {
+                release();
+                id_ = b.dom_.register_reader(); // online
+                if (id_ == b.dom_.npos)
+                {
+                    if (!turned_away_)
+                        b.refused_.fetch_add(1, std::memory_order_relaxed);
+                    turned_away_ = true;
+                    return nullptr;
+                }
+                turned_away_ = false;
+                b_ = &b;
+            }
+            // Until the epoch is stable across the announcement
+            for (uint64_t e = b.dom_.online(id_);; e = b.dom_.online(id_))
+                if (b.dom_.epoch() == e)
+                {
+                    seen_ = e;
+                    return &b.live(e);
+                }
+        }
+
+        void release()
+        {
+            if (b_)
+                b_->dom_.unregister_reader(id_);
+            b_ = nullptr;
+            seen_ = 0;
+        }
+
+        const Block *b_ = nullptr;
+        std::size_t id_ = 0;
+        uint64_t seen_ = 0; // epoch announced; 0 = none (epochs start at 1)
+        bool turned_away_ = false;
+    };
+} // namespace regbus
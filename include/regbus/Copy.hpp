@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define REGBUS_HAS_NT_STORES 1
+#define REGBUS_NT_ALIGN 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REGBUS_HAS_NT_STORES 1
+#define REGBUS_NT_ALIGN 16
+#else
+#define REGBUS_HAS_NT_STORES 0
+#define REGBUS_NT_ALIGN 1
+#endif
+
+// Payloads of at least this many bytes are published with non-temporal
+// stores (default 256 KiB: large enough that the writer would otherwise
+// flush a good part of its L2 for data it never reads back).
+#ifndef REGBUS_NT_THRESHOLD
+#define REGBUS_NT_THRESHOLD (256u * 1024u)
+#endif
+
+namespace regbus
+{
+    // Copy n bytes with non-temporal (cache-bypassing) stores, then fence so
+    // the data is globally visible before a following release store.
+    // A misaligned head is copied normally; memcpy without SSE2.
+    inline void stream_copy(void *dst, const void *src, std::size_t n)
+    {
+#if REGBUS_HAS_NT_STORES
+        char *d = static_cast<char *>(dst);
+        const char *s = static_cast<const char *>(src);
+        std::size_t head = (REGBUS_NT_ALIGN - (reinterpret_cast<uintptr_t>(d) & (REGBUS_NT_ALIGN - 1))) & (REGBUS_NT_ALIGN - 1);
+        if (head > n)
+            head = n;
+        std::memcpy(d, s, head);
+        d += head;
+        s += head;
+        n -= head;
+        const std::size_t body = n & ~std::size_t(4 * REGBUS_NT_ALIGN - 1);
+#if defined(__AVX__)
+        for (std::size_t i = 0; i < body; i += 128)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 32));
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 64));
+            const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 96));
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(d + i), a);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(d + i + 32), b);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(d + i + 64), c);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(d + i + 96), e);
+        }
+#else
+        for (std::size_t i = 0; i < body; i += 64)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 32));
+            const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i *>(d + i), a);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(d + i + 16), b);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(d + i + 32), c);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(d + i + 48), e);
+        }
+#endif
+        if (body != n)
+            std::memcpy(d + body, s + body, n - body);
+        _mm_sfence();
+#else
+        std::memcpy(dst, src, n);
+#endif
+    }
+
+    // Copy n bytes in 1 KiB steps while prefetching 4 KiB ahead of the
+    // source, so a large payload last written by another core streams in
+    // instead of missing line by line.
+    inline void prefetch_copy(void *dst, const void *src, std::size_t n)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        constexpr std::size_t step = 1024, ahead = 4096;
+        char *d = static_cast<char *>(dst);
+        const char *s = static_cast<const char *>(src);
+        for (std::size_t off = 0; off < n; off += step)
+        {
+            const std::size_t end = off + ahead + step < n ? off + ahead + step : n;
+            for (std::size_t p = off + ahead; p < end; p += 64)
+                __builtin_prefetch(s + p, 0, 0);
+            std::memcpy(d + off, s + off, n - off < step ? n - off : step);
+        }
+#else
+        std::memcpy(dst, src, n);
+#endif
+    }
+
+    // Publish-side copy: ordinary memcpy below REGBUS_NT_THRESHOLD, streaming above
+    inline void copy_payload(void *dst, const void *src, std::size_t n)
+    {
+        if (n >= REGBUS_NT_THRESHOLD)
+            stream_copy(dst, src, n);
+        else
+            std::memcpy(dst, src, n);
+    }
+
+    // Copy policies for DBReg<T, Copy>, chosen per key with
+    // Traits::copy (e.g. using copy = regbus::LargePayloadCopy<>;).
+    // store() publishes into a slot, load() copies a slot out.
+    struct PlainCopy
+    {
+        static inline void store(void *d, const void *s, std::size_t n) { std::memcpy(d, s, n); }
+        static inline void load(void *d, const void *s, std::size_t n) { std::memcpy(d, s, n); }
+    };
+
+    // Non-temporal publish for payloads >= MinBytes: the writer does not
+    // evict its own working set for data it never reads back
+    template <std::size_t MinBytes = REGBUS_NT_THRESHOLD>
+    struct StreamingCopy
+    {
+        static inline void store(void *d, const void *s, std::size_t n)
+        {
+            if (n >= MinBytes)
+                stream_copy(d, s, n);
+            else
+                std::memcpy(d, s, n);
+        }
+        static inline void load(void *d, const void *s, std::size_t n) { std::memcpy(d, s, n); }
+    };
+
+    // Prefetching read for payloads >= MinBytes
+    template <std::size_t MinBytes = 64 * 1024>
+    struct PrefetchCopy
+    {
+        static inline void store(void *d, const void *s, std::size_t n) { std::memcpy(d, s, n); }
+        static inline void load(void *d, const void *s, std::size_t n)
+        {
+            if (n >= MinBytes)
+                prefetch_copy(d, s, n);
+            else
+                std::memcpy(d, s, n);
+        }
+    };
+
+    // Both: streaming writes and prefetching reads
+    template <std::size_t StreamMin = REGBUS_NT_THRESHOLD, std::size_t PrefetchMin = 64 * 1024>
+    struct LargePayloadCopy
+    {
+        static inline void store(void *d, const void *s, std::size_t n) { StreamingCopy<StreamMin>::store(d, s, n); }
+        static inline void load(void *d, const void *s, std::size_t n) { PrefetchCopy<PrefetchMin>::load(d, s, n); }
+    };
+} // namespace regbus
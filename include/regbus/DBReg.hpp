@@ -4,58 +4,120 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "Copy.hpp"
+#include "Futex.hpp"
+#include "SeqBuffer.hpp"
+
 namespace regbus
 {
-    template <typename T>
+    // Copy selects how payloads move in and out of the slots (see Copy.hpp);
+    // PlainCopy keeps the ordinary assignments.
+    template <typename T, typename Copy = PlainCopy>
     class DBReg
     {
         static_assert(std::is_trivially_copyable<T>::value,
                       "DBReg<T>: T must be trivially copyable (no heap, fast copy).");
 
     public:
-        DBReg() : idx_(0), has_(false)
+        inline void write(const T &v)
         {
-            seq_[0].store(0);
-            seq_[1].store(0);
+            if constexpr (std::is_same<Copy, PlainCopy>::value)
+                slots_.back() = v; // single POD copy
+            else
+                Copy::store(&slots_.back(), &v, sizeof(T));
+            // seq_cst RMW (no extra fence on x86) + load pairs with wait_until's
+            // announce: either the waiter sees seq s or we see the waiter
+            bool wake = false;
+            slots_.publish([&](uint32_t)
+                           { wake = waiters_.load(std::memory_order_seq_cst) != 0; });
+            if (wake)
+                futex_wake_all(slots_.counter());
         }
 
-        inline void write(const T &v)
+        inline bool read(T &out, uint32_t *out_seq = nullptr) const
         {
-            uint32_t cur = idx_.load(std::memory_order_acquire), nxt = cur ^ 1u;
-            buf_[nxt] = v; // single POD copy
-            uint32_t s = seq_ctr_.fetch_add(1, std::memory_order_acq_rel) + 1;
-            seq_[nxt].store(s, std::memory_order_release);
-            idx_.store(nxt, std::memory_order_release);
-            has_.store(true, std::memory_order_release);
+            if constexpr (std::is_same<Copy, PlainCopy>::value)
+            {
+                T tmp;
+                if (!slots_.visit([&](const T &s)
+                                  { tmp = s; }, out_seq))
+                    return false;
+                out = tmp;
+                return true;
+            }
+            else
+            {
+                // Straight into out (large payloads: no second copy); a
+                // torn copy is overwritten by the retry
+                return slots_.visit([&](const T &s)
+                                    { Copy::load(&out, &s, sizeof(T)); }, out_seq);
+            }
         }
 
-        inline bool read(T &out, uint32_t *out_seq = nullptr) const
+        inline bool has() const { return slots_.has(); }
+
+        // Sleeps until pred(const T &) holds for a published value (true,
+        // value in *out) or timeout_us passes (false; 0 = wait forever).
+        // pred runs on the waiter, once per new publish; writers only make
+        // the wake syscall while someone is waiting.
+        template <typename Pred>
+        inline bool wait_until(Pred &&pred, uint64_t timeout_us = 0, T *out = nullptr) const
         {
-            if (!has_.load(std::memory_order_acquire))
-                return false;
+            const uint64_t deadline = timeout_us ? detail::steady_us() + timeout_us : 0;
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            struct Leave
+            {
+                std::atomic<uint32_t> &w;
+                ~Leave() { w.fetch_sub(1, std::memory_order_relaxed); }
+            } leave{waiters_};
+
+            T v{};
+            uint32_t seen = 0, spins = 0;
+            bool evaluated = false;
             for (;;)
             {
-                uint32_t i1 = idx_.load(std::memory_order_acquire);
-                uint32_t s1 = seq_[i1].load(std::memory_order_acquire);
-                T tmp = buf_[i1];
-                uint32_t i2 = idx_.load(std::memory_order_acquire);
-                if (i1 == i2 && s1 == seq_[i1].load(std::memory_order_acquire))
+                const uint32_t s = slots_.counter().load(std::memory_order_seq_cst);
+                if (slots_.has() && (!evaluated || seen != s))
+                {
+                    read(v, &seen);
+                    evaluated = true;
+                    if (pred(static_cast<const T &>(v)))
+                    {
+                        if (out)
+                            *out = v;
+                        return true;
+                    }
+                }
+                uint64_t left = 0;
+                if (deadline)
+                {
+                    const uint64_t now = detail::steady_us();
+                    if (now >= deadline)
+                        return false;
+                    left = deadline - now;
+                }
+                if (seen != s)
                 {
-                    out = tmp;
-                    if (out_seq)
-                        *out_seq = s1;
-                    return true;
+                    // Write s is still publishing and may have missed our announce
+                    if (++spins < 64)
+                        std::this_thread::yield();
+                    else
+                        futex_wait(slots_.counter(), s, left && left < 50 ? left : 50);
+                    continue;
                 }
+                spins = 0;
+                futex_wait(slots_.counter(), s, left);
             }
         }
 
-        inline bool has() const { return has_.load(std::memory_order_acquire); }
+        // Sequence of the latest write started (0 = never written). Cheap change
+        // detection without copying T; read() returns the seq actually seen.
+        inline uint32_t seq() const { return slots_.seq(); }
+
+        inline WaitStamp stamp() const { return slots_.stamp(); }
 
     private:
-        alignas(16) T buf_[2]{}; // avoid false sharing / misalignment
-        std::atomic<uint32_t> seq_[2];
-        std::atomic<uint32_t> seq_ctr_{0};
-        std::atomic<uint32_t> idx_;
-        std::atomic<bool> has_;
+        SeqBuffer<T> slots_;
+        mutable std::atomic<uint32_t> waiters_{0}; // wait_until() callers
     };
 } // namespace regbus
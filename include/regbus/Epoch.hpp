@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "BitReg.hpp"
+#include "Futex.hpp"
+
+namespace regbus
+{
+    // EpochDomain<MaxReaders>: quiescent-state tracking (QSBR) for swapping a
+    // shared object and knowing when the old version is no longer in use.
+    //
+    // Readers register once and call quiescent(id) between critical sections,
+    // i.e. at points where they hold no reference into shared versions. That
+    // is a single store of the current epoch into the reader's own line.
+    // Writers publish the new version, then synchronize(): it advances the
+    // global epoch and returns once every online reader has announced it, so
+    // no reader can still see the old version.
+    //
+    // A reader about to block (sleep, I/O, a long wait) goes offline() so it
+    // does not hold up writers, and online() again before touching shared data.
+    template <std::size_t MaxReaders = 64>
+    class EpochDomain
+    {
+        static_assert(MaxReaders >= 1 && MaxReaders <= 64, "EpochDomain: MaxReaders must be in [1, 64]");
+
+    public:
+        static constexpr std::size_t max_readers = MaxReaders;
+        static constexpr std::size_t npos = MaxReaders;
+
+        // Returns a reader id, already online (npos when full)
+        inline std::size_t register_reader()
+        {
+            uint64_t m = used_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const uint64_t free = ~m & all;
+                if (!free)
+                    return npos;
+                const std::size_t i = detail::ctz64(free);
+                if (used_.compare_exchange_weak(m, m | (uint64_t(1) << i), std::memory_order_acq_rel, std::memory_order_relaxed))
+                {
+                    online(i);
+                    return i;
+                }
+            }
+        }
+
+        inline void unregister_reader(std::size_t id)
+        {
+            slots_[id].epoch.store(offline_epoch, std::memory_order_release);
+            used_.fetch_and(~(uint64_t(1) << id), std::memory_order_release);
+        }
+
+        // Reader: no references into shared versions held past this point.
+        // Release keeps the section's loads before the announcement; on x86
+        // and other TSO targets it is a plain store.
+        inline void quiescent(std::size_t id)
+        {
+            slots_[id].epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        inline void offline(std::size_t id) { slots_[id].epoch.store(offline_epoch, std::memory_order_release); }
+
+        // The fence pairs with advance(): a synchronize() running concurrently
+        // either sees us online or we see its new version afterwards.
+        // Returns the epoch announced.
+        inline uint64_t online(std::size_t id)
+        {
+            const uint64_t e = epoch_.load(std::memory_order_acquire);
+            slots_[id].epoch.store(e, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return e;
+        }
+
+        // Writer, non-blocking form: advance() starts a grace period and
+        // returns its target; quiesced(target) polls whether it has ended.
+        inline uint64_t advance() { return epoch_.fetch_add(1, std::memory_order_seq_cst) + 1; }
+
+        inline bool quiesced(uint64_t target) const
+        {
+            // Pairs with the fence in online(): an announcement made before
+            // the reader missed our advance() is visible below
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (uint64_t m = used_.load(std::memory_order_seq_cst); m; m &= m - 1)
+            {
+                const uint64_t e = slots_[detail::ctz64(m)].epoch.load(std::memory_order_acquire);
+                if (e != offline_epoch && e < target)
+                    return false;
+            }
+            return true;
+        }
+
+        // Waits for a full grace period: true once every reader online at the
+        // call has passed a quiescent point, false on timeout (0 = forever).
+        // Must not be called from a registered reader that is online.
+        inline bool synchronize(uint64_t timeout_us = 0)
+        {
+            return wait(advance(), timeout_us);
+        }
+
+        // Same, for a target from advance()
+        inline bool wait(uint64_t target, uint64_t timeout_us = 0) const
+        {
+            const uint64_t deadline = timeout_us ? detail::steady_us() + timeout_us : 0;
+            for (uint32_t spins = 0; !quiesced(target); ++spins)
+            {
+                if (deadline && detail::steady_us() >= deadline)
+                    return false;
+                // Readers never wake us: yield briefly, then nap
+                if (spins < 64)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            return true;
+        }
+
+        inline uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+        inline std::size_t readers() const { return std::size_t(detail::popcount64(used_.load(std::memory_order_relaxed))); }
+
+    private:
+        static constexpr uint64_t offline_epoch = 0;
+        static constexpr uint64_t all = MaxReaders == 64 ? ~uint64_t(0) : (uint64_t(1) << MaxReaders) - 1;
+
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> epoch{offline_epoch};
+        };
+
+        alignas(64) std::atomic<uint64_t> epoch_{1};
+        std::atomic<uint64_t> used_{0};
+        Slot slots_[MaxReaders];
+    };
+} // namespace regbus
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace regbus
+{
+    // Scalar field types understood by exporters/encoders
+    enum class FieldType : uint8_t
+    {
+        Bytes, // opaque
+        Bool,
+        U8,
+        I8,
+        U16,
+        I16,
+        U32,
+        I32,
+        U64,
+        I64,
+        F32,
+        F64
+    };
+
+    // One struct member: name, byte offset, size and scalar type
+    struct Field
+    {
+        const char *name;
+        uint32_t offset;
+        uint32_t size;
+        FieldType type;
+    };
+
+    template <typename T>
+    constexpr FieldType field_type_of()
+    {
+        if constexpr (std::is_same<T, bool>::value)
+            return FieldType::Bool;
+        else if constexpr (std::is_same<T, float>::value)
+            return FieldType::F32;
+        else if constexpr (std::is_same<T, double>::value)
+            return FieldType::F64;
+        else if constexpr (std::is_enum<T>::value)
+            return field_type_of<std::underlying_type_t<T>>();
+        else if constexpr (std::is_integral<T>::value && sizeof(T) == 1)
+            return std::is_signed<T>::value ? FieldType::I8 : FieldType::U8;
+        else if constexpr (std::is_integral<T>::value && sizeof(T) == 2)
+            return std::is_signed<T>::value ? FieldType::I16 : FieldType::U16;
+        else if constexpr (std::is_integral<T>::value && sizeof(T) == 4)
+            return std::is_signed<T>::value ? FieldType::I32 : FieldType::U32;
+        else if constexpr (std::is_integral<T>::value && sizeof(T) == 8)
+            return std::is_signed<T>::value ? FieldType::I64 : FieldType::U64;
+        else
+            return FieldType::Bytes;
+    }
+
+    template <typename M>
+    constexpr Field make_field(const char *name, std::size_t offset)
+    {
+        return Field{name, uint32_t(offset), uint32_t(sizeof(M)), field_type_of<M>()};
+    }
+
+    namespace detail
+    {
+        template <typename Tr, typename = void>
+        struct has_fields : std::false_type
+        {
+        };
+        template <typename Tr>
+        struct has_fields<Tr, std::void_t<decltype(Tr::fields)>> : std::true_type
+        {
+        };
+    } // namespace detail
+
+    // Field list for a key: Traits::fields if provided, else the whole value
+    // as one field named "value" (typed if T is a scalar).
+    template <typename Tr>
+    struct fields_of
+    {
+        using T = typename Tr::type;
+
+        static constexpr std::size_t count()
+        {
+            if constexpr (detail::has_fields<Tr>::value)
+                return sizeof(Tr::fields) / sizeof(Tr::fields[0]);
+            else
+                return 1;
+        }
+
+        static constexpr Field at(std::size_t i)
+        {
+            if constexpr (detail::has_fields<Tr>::value)
+                return Tr::fields[i];
+            else
+                return (void)i, make_field<T>("value", 0);
+        }
+
+        // Every field lies within sizeof(T)
+        static constexpr bool valid()
+        {
+            for (std::size_t i = 0; i < count(); ++i)
+                if (at(i).offset + at(i).size > sizeof(T))
+                    return false;
+            return true;
+        }
+    };
+} // namespace regbus
+
+// Describe a struct member for Traits::fields, e.g.
+//   static constexpr regbus::Field fields[] = {REGBUS_FIELD(IMURaw, t_us), REGBUS_FIELD(IMURaw, ax)};
+#define REGBUS_FIELD(Struct, member) \
+    ::regbus::make_field<decltype(Struct::member)>(#member, offsetof(Struct, member))
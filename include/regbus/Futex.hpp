@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define REGBUS_HAS_FUTEX 1
+#else
+#define REGBUS_HAS_FUTEX 0
+#endif
+
+namespace regbus
+{
+    // Park until w != expected, a wake, the timeout (0 = none) or a spurious
+    // return; callers re-check their condition in a loop. Linux: a private
+    // futex on the word. Elsewhere: a short sleep (bounded polling), so
+    // blocking calls stay correct with coarser latency.
+    inline void futex_wait(const std::atomic<uint32_t> &w, uint32_t expected, uint64_t timeout_us = 0)
+    {
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit word");
+#if REGBUS_HAS_FUTEX
+        timespec ts{}, *tp = nullptr;
+        if (timeout_us)
+        {
+            ts.tv_sec = time_t(timeout_us / 1000000);
+            ts.tv_nsec = long(timeout_us % 1000000) * 1000;
+            tp = &ts;
+        }
+        syscall(SYS_futex, const_cast<uint32_t *>(reinterpret_cast<const uint32_t *>(&w)), FUTEX_WAIT_PRIVATE, expected, tp, nullptr, 0);
+#else
+        if (w.load(std::memory_order_acquire) != expected)
+            return;
+        const uint64_t nap = timeout_us && timeout_us < 50 ? timeout_us : 50;
+        std::this_thread::sleep_for(std::chrono::microseconds(nap));
+#endif
+    }
+
+    // Wake every thread parked on w (no-op without futexes)
+    inline void futex_wake_all(std::atomic<uint32_t> &w)
+    {
+#if REGBUS_HAS_FUTEX
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&w), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+        (void)w;
+#endif
+    }
+
+    // Change stamp of a register for wait sets: started counts writes begun
+    // (a seq_cst RMW in every writer), published the ones readers can see.
+    // started != published while a write is in flight.
+    struct WaitStamp
+    {
+        uint32_t started;
+        uint32_t published;
+    };
+
+    namespace detail
+    {
+        inline uint64_t steady_us()
+        {
+            return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+        }
+    } // namespace detail
+} // namespace regbus
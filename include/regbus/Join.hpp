@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // TimeJoin: aligns samples of several Ring keys to the timestamps of a
+    // reference Ring key (e.g. IMU as reference, GNSS and odometry joined).
+    //
+    // poll(reg, now_us, emit) walks the reference samples written since the
+    // last call and, for each one at time t, calls
+    //     emit(t, const value_t<Ref> &, const value_t<Others> *...)
+    // where each pointer is the sample of that key nearest to t within
+    // tolerance_us, or nullptr if there is none.
+    //
+    // Work is incremental: every key keeps a cursor into its ring that only
+    // moves forward, so a poll costs O(new samples) instead of rescanning.
+    // A reference sample is emitted only once its match is final: every other
+    // key has a sample at or after t, or now_us is past t + tolerance_us (a
+    // closer sample can no longer arrive). Until then poll() stops there and
+    // resumes on the next call, so tuples come out in timestamp order.
+    template <typename Reg, typename Reg::key_type Ref, typename Reg::key_type... Others>
+    class TimeJoin
+    {
+        using Key = typename Reg::key_type;
+
+        template <Key K>
+        struct Pick
+        {
+            static_assert(Reg::template kind<K> == Kind::Ring, "TimeJoin: keys must be Ring keys");
+            typename Reg::template value_t<K> v;
+            bool ok;
+        };
+
+    public:
+        explicit TimeJoin(uint64_t tolerance_us) : tol_(tolerance_us) {}
+
+        template <typename F>
+        std::size_t poll(const Reg &reg, uint64_t now_us, F &&emit)
+        {
+            static_assert(Reg::template kind<Ref> == Kind::Ring, "TimeJoin: reference must be a Ring key");
+            const auto &ref = reg.template history<Ref>();
+            std::size_t n = 0;
+            for (;;)
+            {
+                if (ref_next_ == ref.count())
+                    break;
+                const uint64_t old = ref.oldest();
+                if (ref_next_ < old)
+                {
+                    dropped_ += old - ref_next_; // consumer fell behind a full ring
+                    ref_next_ = old;
+                }
+                uint64_t t;
+                typename Reg::template value_t<Ref> rv;
+                if (!ref.at(ref_next_, t, &rv))
+                    continue; // lapped while reading
+
+                std::tuple<Pick<Others>...> picks;
+                bool ready = true;
+                ((ready = ready && resolve<Others>(reg, t, now_us, std::get<Pick<Others>>(picks))), ...);
+                if (!ready)
+                    break;
+
+                emit(t, rv, (std::get<Pick<Others>>(picks).ok ? &std::get<Pick<Others>>(picks).v : nullptr)...);
+                ++ref_next_;
+                ++n;
+            }
+            return n;
+        }
+
+        // Reference samples overwritten before they could be joined
+        uint64_t dropped() const { return dropped_; }
+
+    private:
+        template <Key K>
+        static constexpr std::size_t slot()
+        {
+            std::size_t i = 0, found = sizeof...(Others);
+            ((Others == K ? (found = i, ++i) : ++i), ...);
+            return found;
+        }
+
+        // Nearest sample of K to t within tolerance; false if not final yet
+        template <Key K>
+        bool resolve(const Reg &reg, uint64_t t, uint64_t now_us, Pick<K> &p)
+        {
+            const auto &h = reg.template history<K>();
+            uint64_t &next = next_[slot<K>()];
+            for (;;)
+            {
+                const uint64_t cnt = h.count(), old = h.oldest();
+                if (next < old)
+                    next = old;
+
+                // Advance past samples at or before t (cursor never moves back)
+                uint64_t tn = 0;
+                bool lapped = false;
+                while (next < cnt)
+                {
+                    if (!h.at(next, tn))
+                    {
+                        lapped = true;
+                        break;
+                    }
+                    if (tn > t)
+                        break;
+                    ++next;
+                }
+                if (lapped)
+                    continue;
+
+                uint64_t tp = 0;
+                typename Reg::template value_t<K> vp;
+                const bool hp = next > old && h.at(next - 1, tp, &vp);
+                const bool hn = next < cnt;
+                if (!hn && !(hp && tp == t) && now_us <= t + tol_)
+                    return false; // a closer sample may still arrive
+
+                p.ok = false;
+                if (hp && t - tp <= tol_)
+                {
+                    p.v = vp;
+                    p.ok = true;
+                }
+                if (hn && tn - t <= tol_ && (!p.ok || tn - t < t - tp))
+                {
+                    if (!h.at(next, tn, &p.v))
+                        continue;
+                    p.ok = true;
+                }
+                return true;
+            }
+        }
+
+        uint64_t tol_;
+        uint64_t ref_next_ = 0;
+        uint64_t dropped_ = 0;
+        std::array<uint64_t, sizeof...(Others)> next_{};
+    };
+} // namespace regbus
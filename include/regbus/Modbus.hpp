@@ -0,0 +1,413 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // Modbus view of a Registry (protocol only: no sockets, no heap).
+    //
+    // Address layout is fixed at compile time, in key-list order:
+    //   - Kind::Data keys -> consecutive 16-bit registers, ceil(sizeof(T)/2) each,
+    //     served both as input registers (FC04) and holding registers (FC03).
+    //     Register j of a key is the value's 16-bit word j (bytes 2j, 2j+1 in
+    //     host order), sent big-endian as Modbus requires: a uint16_t field of
+    //     1 reads as 0x0001. Wider fields keep host word order (low word
+    //     first on little-endian hosts); an odd trailing byte is zero-padded.
+    //     Holding-register writes (FC06/FC16) are accepted only for keys whose
+    //     Traits set `static constexpr bool modbus_writable = true`; partial
+    //     writes patch a fresh snapshot and publish the whole value.
+    //   - Kind::Cmd keys  -> consecutive coils. Reading returns pending();
+    //     writing ON (FC05/FC15) posts T(true), writing OFF is a no-op.
+    //
+    // Every key touched by a request is read once with a coherent snapshot, so a
+    // multi-register read never returns a torn struct.
+    namespace detail
+    {
+        template <typename Tr, typename = void>
+        struct mb_writable : std::false_type
+        {
+        };
+        template <typename Tr>
+        struct mb_writable<Tr, std::void_t<decltype(Tr::modbus_writable)>>
+            : std::integral_constant<bool, Tr::modbus_writable>
+        {
+        };
+
+        inline uint16_t be16(const uint8_t *p) { return uint16_t(p[0] << 8 | p[1]); }
+        inline void put_be16(uint8_t *p, uint16_t v)
+        {
+            p[0] = uint8_t(v >> 8);
+            p[1] = uint8_t(v);
+        }
+    } // namespace detail
+
+    template <typename Reg>
+    class ModbusServer
+    {
+        using Key = typename Reg::key_type;
+
+    public:
+        // Function codes
+        enum : uint8_t
+        {
+            READ_COILS = 0x01,
+            READ_HOLDING = 0x03,
+            READ_INPUT = 0x04,
+            WRITE_COIL = 0x05,
+            WRITE_REGISTER = 0x06,
+            WRITE_COILS = 0x0F,
+            WRITE_REGISTERS = 0x10
+        };
+        // Exception codes
+        enum : uint8_t
+        {
+            ILLEGAL_FUNCTION = 0x01,
+            ILLEGAL_ADDRESS = 0x02,
+            ILLEGAL_VALUE = 0x03
+        };
+
+        static constexpr std::size_t mbap_bytes = 7;
+        static constexpr std::size_t max_adu = 260;
+
+        explicit ModbusServer(Reg &reg) : reg_(reg) {}
+
+        // ---- Address map (compile-time) ----
+        template <Key K>
+        static constexpr uint16_t words() { return uint16_t((sizeof(typename Reg::template value_t<K>) + 1) / 2); }
+
+        // First register of Data key K
+        template <Key K>
+        static constexpr uint16_t register_of()
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "register_of<K>: K must be a Data key");
+            uint32_t a = 0;
+            bool found = false;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto J = decltype(key)::value;
+                found = found || J == K;
+                if constexpr (Reg::template kind<J> == Kind::Data)
+                    if (!found)
+                        a += words<J>(); });
+            return uint16_t(a);
+        }
+
+        // Coil address of Cmd key K
+        template <Key K>
+        static constexpr uint16_t coil_of()
+        {
+            static_assert(Reg::template kind<K> == Kind::Cmd, "coil_of<K>: K must be a Cmd key");
+            uint32_t a = 0;
+            bool found = false;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto J = decltype(key)::value;
+                found = found || J == K;
+                if constexpr (Reg::template kind<J> == Kind::Cmd)
+                    if (!found)
+                        ++a; });
+            return uint16_t(a);
+        }
+
+        static constexpr uint32_t register_count()
+        {
+            uint32_t a = 0;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto J = decltype(key)::value;
+                if constexpr (Reg::template kind<J> == Kind::Data)
+                    a += words<J>(); });
+            return a;
+        }
+
+        static constexpr uint32_t coil_count()
+        {
+            uint32_t a = 0;
+            Reg::for_each_key([&](auto key)
+                              { a += Reg::template kind<decltype(key)::value> == Kind::Cmd; });
+            return a;
+        }
+
+        static_assert(register_count() <= 0x10000u, "ModbusServer: registry exceeds the 16-bit register space");
+
+        // Handle one PDU (function code + data). Returns response PDU length
+        // written to out, which must hold max_adu - mbap_bytes bytes.
+        std::size_t handle_pdu(const uint8_t *pdu, std::size_t n, uint8_t *out)
+        {
+            if (n < 1)
+                return 0;
+            const uint8_t fc = pdu[0];
+            out[0] = fc;
+            if (!known(fc))
+                return exception(out, fc, ILLEGAL_FUNCTION);
+            if (n < 5)
+                return exception(out, fc, ILLEGAL_VALUE);
+            const uint16_t start = detail::be16(pdu + 1);
+            const uint16_t qty = detail::be16(pdu + 3);
+
+            switch (fc)
+            {
+            case READ_HOLDING:
+            case READ_INPUT:
+                if (qty < 1 || qty > 125)
+                    return exception(out, fc, ILLEGAL_VALUE);
+                if (uint32_t(start) + qty > register_count())
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                out[1] = uint8_t(qty * 2);
+                read_registers(start, qty, out + 2);
+                return 2u + qty * 2u;
+
+            case READ_COILS:
+                if (qty < 1 || qty > 2000)
+                    return exception(out, fc, ILLEGAL_VALUE);
+                if (uint32_t(start) + qty > coil_count())
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                out[1] = uint8_t((qty + 7) / 8);
+                std::memset(out + 2, 0, out[1]);
+                read_coils(start, qty, out + 2);
+                return 2u + out[1];
+
+            case WRITE_COIL: // qty field carries the value
+                if (qty != 0xFF00 && qty != 0x0000)
+                    return exception(out, fc, ILLEGAL_VALUE);
+                if (start >= coil_count())
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                if (qty == 0xFF00)
+                {
+                    const uint8_t on = 1;
+                    if (!write_coils(start, 1, &on))
+                        return exception(out, fc, ILLEGAL_ADDRESS);
+                }
+                std::memcpy(out, pdu, 5);
+                return 5;
+
+            case WRITE_REGISTER: // qty field carries the value
+            {
+                if (start >= register_count())
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                uint8_t b[2];
+                detail::put_be16(b, qty);
+                if (!write_registers(start, 1, b))
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                std::memcpy(out, pdu, 5);
+                return 5;
+            }
+
+            case WRITE_COILS:
+                if (qty < 1 || qty > 1968 || n < 6u || pdu[5] != (qty + 7) / 8 || n < 6u + pdu[5])
+                    return exception(out, fc, ILLEGAL_VALUE);
+                if (uint32_t(start) + qty > coil_count())
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                if (!write_coils(start, qty, pdu + 6))
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                std::memcpy(out, pdu, 5);
+                return 5;
+
+            case WRITE_REGISTERS:
+                if (qty < 1 || qty > 123 || n < 6u || pdu[5] != qty * 2 || n < 6u + pdu[5])
+                    return exception(out, fc, ILLEGAL_VALUE);
+                if (uint32_t(start) + qty > register_count())
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                if (!write_registers(start, qty, pdu + 6))
+                    return exception(out, fc, ILLEGAL_ADDRESS);
+                std::memcpy(out, pdu, 5);
+                return 5;
+
+            default:
+                return exception(out, fc, ILLEGAL_FUNCTION);
+            }
+        }
+
+        // Handle every complete Modbus TCP ADU in in[0..n) and append the
+        // responses to out[0..cap). Returns bytes consumed from in; *out_len is
+        // the response length and *answered (optional) the number of responses.
+        // Stops early on a partial ADU or when out is full.
+        std::size_t process(const uint8_t *in, std::size_t n, uint8_t *out, std::size_t cap,
+                            std::size_t *out_len, std::size_t *answered = nullptr)
+        {
+            std::size_t used = 0, w = 0, cnt = 0;
+            while (n - used >= mbap_bytes && cap - w >= max_adu)
+            {
+                const uint8_t *adu = in + used;
+                const uint16_t len = detail::be16(adu + 4); // unit id + PDU
+                if (len < 2 || len > max_adu - 6)
+                {
+                    used = n; // framing lost: drop the rest
+                    break;
+                }
+                if (n - used < 6u + len)
+                    break;
+
+                std::memcpy(out + w, adu, mbap_bytes); // echo transaction/protocol/unit
+                std::size_t plen = detail::be16(adu + 2) == 0
+                                       ? handle_pdu(adu + mbap_bytes, len - 1u, out + w + mbap_bytes)
+                                       : 0;
+                if (plen)
+                {
+                    detail::put_be16(out + w + 4, uint16_t(plen + 1));
+                    w += mbap_bytes + plen;
+                    ++cnt;
+                }
+                used += 6u + len;
+            }
+            *out_len = w;
+            if (answered)
+                *answered = cnt;
+            return used;
+        }
+
+    private:
+        static bool known(uint8_t fc)
+        {
+            switch (fc)
+            {
+            case READ_COILS:
+            case READ_HOLDING:
+            case READ_INPUT:
+            case WRITE_COIL:
+            case WRITE_REGISTER:
+            case WRITE_COILS:
+            case WRITE_REGISTERS:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Word j of v in host order (zero-padded past the end)
+        template <typename T>
+        static uint16_t word_of(const T &v, uint32_t j)
+        {
+            uint16_t w = 0;
+            std::memcpy(&w, reinterpret_cast<const uint8_t *>(&v) + 2 * j, sizeof(T) - 2 * j < 2 ? 1 : 2);
+            return w;
+        }
+        template <typename T>
+        static void set_word(T &v, uint32_t j, uint16_t w)
+        {
+            std::memcpy(reinterpret_cast<uint8_t *>(&v) + 2 * j, &w, sizeof(T) - 2 * j < 2 ? 1 : 2);
+        }
+
+        static std::size_t exception(uint8_t *out, uint8_t fc, uint8_t code)
+        {
+            out[0] = uint8_t(fc | 0x80);
+            out[1] = code;
+            return 2;
+        }
+
+        void read_registers(uint16_t start, uint16_t qty, uint8_t *out) const
+        {
+            const uint32_t end = uint32_t(start) + qty;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    constexpr uint32_t base = register_of<K>(), cnt = words<K>();
+                    const uint32_t lo = start > base ? start : base;
+                    const uint32_t hi = end < base + cnt ? end : base + cnt;
+                    if (lo >= hi)
+                        return;
+                    typename Reg::template value_t<K> v{};
+                    reg_.template read<K>(v); // one coherent snapshot per key
+                    for (uint32_t r = lo; r < hi; ++r)
+                        detail::put_be16(out + (r - start) * 2, word_of(v, r - base));
+                } });
+        }
+
+        // All-or-nothing: fails if any covered key is not writable
+        bool write_registers(uint16_t start, uint16_t qty, const uint8_t *in)
+        {
+            const uint32_t end = uint32_t(start) + qty;
+            bool ok = true;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                    if (overlaps<K>(start, end) &&
+                        !detail::mb_writable<typename Reg::template traits_t<K>>::value)
+                        ok = false; });
+            if (!ok)
+                return false;
+
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    if constexpr (detail::mb_writable<typename Reg::template traits_t<K>>::value)
+                    {
+                        constexpr uint32_t base = register_of<K>(), cnt = words<K>();
+                        if (!overlaps<K>(start, end))
+                            return;
+                        const uint32_t lo = start > base ? start : base;
+                        const uint32_t hi = end < base + cnt ? end : base + cnt;
+                        typename Reg::template value_t<K> v{};
+                        if (lo != base || hi != base + cnt) // partial: patch the latest value
+                            reg_.template read<K>(v);
+                        for (uint32_t r = lo; r < hi; ++r)
+                            set_word(v, r - base, detail::be16(in + (r - start) * 2));
+                        reg_.template write<K>(v);
+                    }
+                } });
+            return true;
+        }
+
+        void read_coils(uint16_t start, uint16_t qty, uint8_t *out) const
+        {
+            const uint32_t end = uint32_t(start) + qty;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Cmd)
+                {
+                    constexpr uint32_t c = coil_of<K>();
+                    if (c >= start && c < end && reg_.template pending<K>())
+                        out[(c - start) / 8] |= uint8_t(1u << ((c - start) % 8));
+                } });
+        }
+
+        // Bits in LSB-first Modbus order; posts T(true) for each ON coil.
+        // All-or-nothing: nothing is posted if any ON coil cannot take T(true).
+        bool write_coils(uint16_t start, uint16_t qty, const uint8_t *bits)
+        {
+            const uint32_t end = uint32_t(start) + qty;
+            auto on = [&](uint32_t c)
+            { return c >= start && c < end && ((bits[(c - start) / 8] >> ((c - start) % 8)) & 1u); };
+            bool ok = true;
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Cmd)
+                    if (!std::is_constructible<typename Reg::template value_t<K>, bool>::value && on(coil_of<K>()))
+                        ok = false; });
+            if (!ok)
+                return false;
+
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Cmd)
+                {
+                    using T = typename Reg::template value_t<K>;
+                    if constexpr (std::is_constructible<T, bool>::value)
+                        if (on(coil_of<K>()))
+                            reg_.template post<K>(T(true));
+                } });
+            return true;
+        }
+
+        template <Key K>
+        static constexpr bool overlaps(uint32_t start, uint32_t end)
+        {
+            return start < register_of<K>() + words<K>() && register_of<K>() < end;
+        }
+
+        Reg &reg_;
+    };
+} // namespace regbus
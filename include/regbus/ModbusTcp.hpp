@@ -0,0 +1,246 @@
+#pragma once
+
+// Modbus TCP gateway over POSIX sockets (Linux/macOS/lwIP-compatible).
+// Single-threaded: call poll_once() from one service thread. No heap.
+// Sends never wait: responses a peer is not reading stay in its own tx
+// backlog, and its further requests are left unread until that drains,
+// so one slow peer cannot stall the others.
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Modbus.hpp"
+
+namespace regbus
+{
+    template <typename Reg, std::size_t MaxClients = 4>
+    class ModbusTcpGateway
+    {
+        using Server = ModbusServer<Reg>;
+        static constexpr std::size_t rx_cap = 8 * Server::max_adu;
+        static constexpr std::size_t tx_cap = 8 * Server::max_adu;
+
+    public:
+        explicit ModbusTcpGateway(Reg &reg) : server_(reg)
+        {
+            for (auto &c : clients_)
+            {
+                c.fd = -1;
+                c.len = c.tx_off = c.tx_len = 0;
+            }
+        }
+        ~ModbusTcpGateway() { close(); }
+
+        ModbusTcpGateway(const ModbusTcpGateway &) = delete;
+        ModbusTcpGateway &operator=(const ModbusTcpGateway &) = delete;
+
+        // Bind and listen (port 0 picks an ephemeral port; see port())
+        bool listen(uint16_t port, const char *addr = "0.0.0.0")
+        {
+            close();
+            listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (listen_fd_ < 0)
+                return false;
+            int one = 1;
+            ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+            sockaddr_in sa{};
+            sa.sin_family = AF_INET;
+            sa.sin_port = htons(port);
+            if (::inet_pton(AF_INET, addr, &sa.sin_addr) != 1 ||
+                ::bind(listen_fd_, reinterpret_cast<sockaddr *>(&sa), sizeof(sa)) != 0 ||
+                ::listen(listen_fd_, int(MaxClients)) != 0)
+            {
+                close();
+                return false;
+            }
+            set_nonblocking(listen_fd_);
+            return true;
+        }
+
+        uint16_t port() const
+        {
+            sockaddr_in sa{};
+            socklen_t len = sizeof(sa);
+            if (listen_fd_ < 0 || ::getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&sa), &len) != 0)
+                return 0;
+            return ntohs(sa.sin_port);
+        }
+
+        // Wait up to timeout_ms for activity, accept new clients and answer
+        // every complete request received. Requests arriving together are
+        // handled as one batch and answered with a single send().
+        // Returns the number of requests answered, or -1 if not listening.
+        int poll_once(int timeout_ms)
+        {
+            if (listen_fd_ < 0)
+                return -1;
+            std::array<pollfd, MaxClients + 1> fds{};
+            fds[0] = {listen_fd_, POLLIN, 0};
+            for (std::size_t i = 0; i < MaxClients; ++i) // fd -1 is ignored by poll
+                fds[i + 1] = {clients_[i].fd, short(clients_[i].tx_len ? POLLOUT : POLLIN), 0};
+
+            if (::poll(fds.data(), fds.size(), timeout_ms) <= 0)
+                return 0;
+
+            if (fds[0].revents & POLLIN)
+                accept_all();
+
+            int answered = 0;
+            for (std::size_t i = 0; i < MaxClients; ++i)
+                if (fds[i + 1].fd >= 0 && fds[i + 1].revents)
+                    answered += service(clients_[i], fds[i + 1].revents);
+            return answered;
+        }
+
+        void close()
+        {
+            for (auto &c : clients_)
+                drop(c);
+            if (listen_fd_ >= 0)
+                ::close(listen_fd_);
+            listen_fd_ = -1;
+        }
+
+    private:
+        struct Client
+        {
+            int fd;
+            std::size_t len;
+            std::size_t tx_off, tx_len; // unsent responses: tx[tx_off, tx_len)
+            std::array<uint8_t, rx_cap> rx;
+            std::array<uint8_t, tx_cap> tx;
+        };
+
+        static void set_nonblocking(int fd) { ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+
+        void accept_all()
+        {
+            for (;;)
+            {
+                int fd = ::accept(listen_fd_, nullptr, nullptr);
+                if (fd < 0)
+                    return;
+                Client *slot = nullptr;
+                for (auto &c : clients_)
+                    if (c.fd < 0)
+                    {
+                        slot = &c;
+                        break;
+                    }
+                if (!slot)
+                {
+                    ::close(fd); // full: refuse
+                    continue;
+                }
+                int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                set_nonblocking(fd);
+                slot->fd = fd;
+                slot->len = 0;
+                slot->tx_off = slot->tx_len = 0;
+            }
+        }
+
+        int service(Client &c, short revents)
+        {
+            if (revents & (POLLERR | POLLNVAL))
+            {
+                drop(c);
+                return 0;
+            }
+            if (revents & POLLOUT)
+            {
+                if (!flush(c))
+                {
+                    drop(c);
+                    return 0;
+                }
+                return c.tx_len ? 0 : answer(c); // drained: serve what is queued
+            }
+            ssize_t r = ::recv(c.fd, c.rx.data() + c.len, rx_cap - c.len, 0);
+            if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+            {
+                drop(c);
+                return 0;
+            }
+            if (r < 0)
+                return 0;
+            c.len += std::size_t(r);
+            return answer(c);
+        }
+
+        // Answer complete requests in rx while the tx backlog is empty
+        int answer(Client &c)
+        {
+            int answered = 0;
+            std::size_t off = 0;
+            while (!c.tx_len)
+            {
+                std::size_t n = 0;
+                std::size_t used = server_.process(c.rx.data() + off, c.len - off, c.tx.data(), tx_cap, &c.tx_len, &n);
+                answered += int(n);
+                c.tx_off = 0;
+                if (!flush(c))
+                {
+                    drop(c);
+                    return answered;
+                }
+                off += used;
+                if (!used)
+                    break;
+            }
+            std::memmove(c.rx.data(), c.rx.data() + off, c.len - off);
+            c.len -= off;
+            if (c.len == rx_cap && !c.tx_len) // oversized garbage: resync by dropping the peer
+                drop(c);
+            return answered;
+        }
+
+        // Sends as much of the backlog as the socket takes; false on error
+        static bool flush(Client &c)
+        {
+            while (c.tx_off < c.tx_len)
+            {
+#ifdef MSG_NOSIGNAL
+                ssize_t w = ::send(c.fd, c.tx.data() + c.tx_off, c.tx_len - c.tx_off, MSG_NOSIGNAL);
+#else
+                ssize_t w = ::send(c.fd, c.tx.data() + c.tx_off, c.tx_len - c.tx_off, 0); // set SO_NOSIGPIPE / ignore SIGPIPE on this platform
+#endif
+                if (w < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return errno == EAGAIN || errno == EWOULDBLOCK; // rest waits for POLLOUT
+                }
+                c.tx_off += std::size_t(w);
+            }
+            c.tx_off = c.tx_len = 0;
+            return true;
+        }
+
+        void drop(Client &c)
+        {
+            if (c.fd >= 0)
+                ::close(c.fd);
+            c.fd = -1;
+            c.len = 0;
+            c.tx_off = c.tx_len = 0;
+        }
+
+        Server server_;
+        int listen_fd_ = -1;
+        std::array<Client, MaxClients> clients_;
+    };
+} // namespace regbus
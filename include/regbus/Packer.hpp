@@ -0,0 +1,326 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // Optional per-key telemetry Traits (all have defaults):
+    //   static constexpr uint32_t priority    = 1;  // weight: share of bytes under contention
+    //   static constexpr uint32_t min_rate_hz = 0;  // resend even if unchanged (0 = off)
+    //   static constexpr uint32_t max_rate_hz = 0;  // never send faster (0 = unlimited)
+    namespace detail
+    {
+        template <typename Tr, typename = void>
+        struct tlm_priority : std::integral_constant<uint32_t, 1>
+        {
+        };
+        template <typename Tr>
+        struct tlm_priority<Tr, std::void_t<decltype(Tr::priority)>>
+            : std::integral_constant<uint32_t, Tr::priority>
+        {
+        };
+
+        template <typename Tr, typename = void>
+        struct tlm_min_rate : std::integral_constant<uint32_t, 0>
+        {
+        };
+        template <typename Tr>
+        struct tlm_min_rate<Tr, std::void_t<decltype(Tr::min_rate_hz)>>
+            : std::integral_constant<uint32_t, Tr::min_rate_hz>
+        {
+        };
+
+        template <typename Tr, typename = void>
+        struct tlm_max_rate : std::integral_constant<uint32_t, 0>
+        {
+        };
+        template <typename Tr>
+        struct tlm_max_rate<Tr, std::void_t<decltype(Tr::max_rate_hz)>>
+            : std::integral_constant<uint32_t, Tr::max_rate_hz>
+        {
+        };
+    } // namespace detail
+
+    // Packer: fills MTU-sized telemetry frames from Data registers under a
+    // byte-per-second budget, sharing it across keys by priority weight.
+    //
+    // Each cycle(now_us, sink):
+    //   1. refills the byte budget (token bucket, capped at burst_bytes),
+    //   2. first serves keys overdue for their min rate,
+    //   3. then sends keys whose seq changed since last sent, honouring max
+    //      rates, in weighted fair order (start-time tags: each send advances
+    //      the key's tag by bytes / priority, the smallest tag goes next)
+    //      until nothing is pending or the next key does not fit the budget
+    //      (each key is sent at most once per cycle),
+    //   4. hands every completed frame to sink(const uint8_t *data, size_t n).
+    //
+    // A key that has been idle may run ahead of its share by up to
+    // quantum_bytes * priority bytes when it becomes active again.
+    //
+    // Record layout (little-endian): u16 key index, u16 payload size, u32 seq,
+    // payload bytes. Frames are a plain concatenation of records.
+    // Values are read with coherent snapshots (Registry::read). No heap.
+    // Data keys whose record does not fit in one MTU are never sent
+    // (sendable(i) is false for them); each change of such a key is counted
+    // in stats(i).dropped and dropped().
+    //
+    // With Options<Key>::config, each cycle follows the live RegistryConfig:
+    // keys not bridged() are not sent and max_rate_hz[i] overrides the Traits
+    // max rate, but never below the key's Traits min_rate_hz.
+    template <typename Reg, std::size_t MTU = 1200>
+    class Packer
+    {
+    public:
+        static constexpr std::size_t header_bytes = 8;
+        static constexpr std::size_t N = Reg::size();
+
+        struct Stats
+        {
+            uint64_t sent;    // records emitted
+            uint64_t bytes;   // record bytes emitted (header + payload)
+            uint64_t dropped; // changes never sent: record exceeds the MTU
+        };
+
+        Packer(uint32_t bytes_per_sec, uint32_t quantum_bytes = 64, uint32_t burst_bytes = 4 * MTU)
+            : rate_(bytes_per_sec), quantum_(quantum_bytes), burst_(burst_bytes), budget_(burst_bytes)
+        {
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                using Tr = typename Reg::template traits_t<K>;
+                constexpr std::size_t i = Reg::template index<K>();
+                if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    sendable_[i] = fits<K>();
+                    static_assert(detail::tlm_priority<Tr>::value > 0, "Packer: priority must be >= 1");
+                    constexpr uint32_t lo = detail::tlm_min_rate<Tr>::value;
+                    constexpr uint32_t hi = detail::tlm_max_rate<Tr>::value;
+                    static_assert(!lo || !hi || lo <= hi, "Packer: min_rate_hz > max_rate_hz");
+                    weight_[i] = detail::tlm_priority<Tr>::value;
+                    min_gap_us_[i] = lo ? 1000000u / lo : 0;
+                    max_gap_us_[i] = hi ? 1000000u / hi : 0;
+                } });
+        }
+
+        template <typename Sink>
+        std::size_t cycle(const Reg &reg, uint64_t now_us, Sink &&sink)
+        {
+            refill(now_us);
+            ++cycle_;
+            std::size_t emitted = 0;
+            const typename Reg::config_reader_t::Scope scope(config_, reg);
+            const typename Reg::config_t *cfg = scope.get();
+
+            // Pass 1: min-rate guarantees (also resends unchanged values)
+            Reg::for_each_key([&](auto key)
+                              {
+                constexpr auto K = decltype(key)::value;
+                if constexpr (Reg::template kind<K> == Kind::Data && fits<K>())
+                {
+                    constexpr std::size_t i = Reg::template index<K>();
+                    if (cfg && !cfg->bridged(i))
+                        return;
+                    if (min_gap_us_[i] && reg.template has<K>() && now_us - last_us_[i] >= min_gap_us_[i] &&
+                        budget_ >= record_bytes<K>())
+                        emitted += emit<K>(reg, now_us, sink);
+                }
+                else if constexpr (Reg::template kind<K> == Kind::Data)
+                {
+                    constexpr std::size_t i = Reg::template index<K>();
+                    if (cfg && !cfg->bridged(i))
+                        return;
+                    const uint32_t s = reg.template seq<K>();
+                    if (reg.template has<K>() && s != last_seq_[i])
+                    {
+                        last_seq_[i] = s; // count each change once
+                        stats_[i].dropped++;
+                        dropped_++;
+                    }
+                } });
+
+            // Pass 2: changed keys, smallest start tag first
+            const uint64_t bank = uint64_t(quantum_) * tag_scale;
+            for (;;)
+            {
+                std::size_t best = N;
+                uint64_t best_tag = 0;
+                uint32_t best_need = 0;
+                Reg::for_each_key([&](auto key)
+                                  {
+                    constexpr auto K = decltype(key)::value;
+                    if constexpr (Reg::template kind<K> == Kind::Data && fits<K>())
+                    {
+                        constexpr std::size_t i = Reg::template index<K>();
+                        if (!backlogged<K>(reg, now_us, cfg))
+                            return;
+                        const uint64_t floor = vtime_ > bank ? vtime_ - bank : 0; // idle keys bank one quantum
+                        const uint64_t tag = tag_[i] > floor ? tag_[i] : floor;
+                        if (best == N || tag < best_tag)
+                        {
+                            best = i;
+                            best_tag = tag;
+                            best_need = record_bytes<K>();
+                        }
+                    } });
+                if (best == N || budget_ < best_need)
+                    break; // the next key in line waits for budget
+                std::size_t n = 0;
+                Reg::for_each_key([&](auto key)
+                                  {
+                    constexpr auto K = decltype(key)::value;
+                    if constexpr (Reg::template kind<K> == Kind::Data && fits<K>())
+                        if (Reg::template index<K>() == best)
+                            n = emit<K>(reg, now_us, sink); });
+                if (!n)
+                    break;
+                emitted += n;
+                vtime_ = best_tag;
+                tag_[best] = best_tag + uint64_t(best_need) * tag_scale / weight_[best];
+            }
+
+            flush(sink);
+            return emitted;
+        }
+
+        const Stats &stats(std::size_t i) const { return stats_[i]; }
+
+        // Achieved send rate of key i since the first cycle (Hz)
+        double achieved_hz(std::size_t i, uint64_t now_us) const
+        {
+            uint64_t dt = now_us - start_us_;
+            return dt ? double(stats_[i].sent) * 1e6 / double(dt) : 0.0;
+        }
+
+        uint32_t budget() const { return budget_; }
+
+        // Changes of oversized keys that could not be sent (all keys)
+        uint64_t dropped() const { return dropped_; }
+
+        // False for keys that are not Data or whose record exceeds the MTU
+        bool sendable(std::size_t i) const { return sendable_[i]; }
+
+    private:
+        template <typename Reg::key_type K>
+        static constexpr uint32_t record_bytes()
+        {
+            return uint32_t(header_bytes + sizeof(typename Reg::template value_t<K>));
+        }
+
+        static constexpr uint64_t tag_scale = 1u << 16; // keeps bytes / weight exact enough
+
+        template <typename Reg::key_type K>
+        static constexpr bool fits() { return record_bytes<K>() <= MTU; }
+
+        template <typename Reg::key_type K>
+        bool backlogged(const Reg &reg, uint64_t now_us, const typename Reg::config_t *cfg) const
+        {
+            constexpr std::size_t i = Reg::template index<K>();
+            if (served_[i] == cycle_ || !reg.template has<K>() || reg.template seq<K>() == last_seq_[i])
+                return false;
+            if (cfg && !cfg->bridged(i))
+                return false;
+            const uint32_t hz = cfg ? cfg->max_rate_hz[i] : 0;
+            uint32_t gap = hz ? 1000000u / hz : max_gap_us_[i];
+            if (min_gap_us_[i] && gap > min_gap_us_[i])
+                gap = min_gap_us_[i]; // a config cap never undercuts the min rate
+            return !gap || !stats_[i].sent || now_us - last_us_[i] >= gap;
+        }
+
+        void refill(uint64_t now_us)
+        {
+            if (!started_)
+            {
+                started_ = true;
+                start_us_ = last_us_refill_ = now_us;
+                return;
+            }
+            credit_ += (now_us - last_us_refill_) * rate_; // byte-microseconds
+            last_us_refill_ = now_us;
+            uint64_t b = budget_ + credit_ / 1000000u;
+            credit_ %= 1000000u;
+            budget_ = uint32_t(b > burst_ ? burst_ : b);
+        }
+
+        template <typename Reg::key_type K, typename Sink>
+        std::size_t emit(const Reg &reg, uint64_t now_us, Sink &sink)
+        {
+            using T = typename Reg::template value_t<K>;
+            constexpr std::size_t i = Reg::template index<K>();
+            constexpr uint32_t need = record_bytes<K>();
+
+            T v{};
+            uint32_t s = 0;
+            if (!reg.template read<K>(v, &s))
+                return 0;
+            if (len_ + need > MTU)
+                flush(sink);
+
+            uint8_t *p = frame_.data() + len_;
+            put_u16(p, uint16_t(i));
+            put_u16(p + 2, uint16_t(sizeof(T)));
+            put_u32(p + 4, s);
+            std::memcpy(p + header_bytes, &v, sizeof(T));
+            len_ += need;
+
+            budget_ -= need;
+            last_seq_[i] = s;
+            last_us_[i] = now_us;
+            served_[i] = cycle_;
+            stats_[i].sent++;
+            stats_[i].bytes += need;
+            return 1;
+        }
+
+        template <typename Sink>
+        void flush(Sink &sink)
+        {
+            if (len_)
+                sink(static_cast<const uint8_t *>(frame_.data()), len_);
+            len_ = 0;
+        }
+
+        static void put_u16(uint8_t *p, uint16_t v)
+        {
+            p[0] = uint8_t(v);
+            p[1] = uint8_t(v >> 8);
+        }
+        static void put_u32(uint8_t *p, uint32_t v)
+        {
+            put_u16(p, uint16_t(v));
+            put_u16(p + 2, uint16_t(v >> 16));
+        }
+
+        uint32_t rate_;
+        uint32_t quantum_;
+        uint32_t burst_;
+        uint32_t budget_;
+        bool started_ = false;
+        uint64_t start_us_ = 0;
+        uint64_t last_us_refill_ = 0;
+        uint64_t credit_ = 0;
+        uint32_t cycle_ = 0;
+
+        std::array<uint32_t, N> weight_{};
+        std::array<uint32_t, N> min_gap_us_{};
+        std::array<uint32_t, N> max_gap_us_{};
+        std::array<uint64_t, N> tag_{}; // start tag: virtual bytes / weight
+        std::array<uint32_t, N> last_seq_{};
+        std::array<uint64_t, N> last_us_{};
+        std::array<uint32_t, N> served_{}; // cycle_ in which key was last sent
+        uint64_t vtime_ = 0;               // tag of the last key sent
+        uint64_t dropped_ = 0;
+        std::array<Stats, N> stats_{};
+        std::array<bool, N> sendable_{};
+
+        std::array<uint8_t, MTU> frame_{};
+        std::size_t len_ = 0;
+
+        typename Reg::config_reader_t config_{};
+    };
+} // namespace regbus
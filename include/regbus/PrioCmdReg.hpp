@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace regbus
+{
+    // PrioCmdReg<T, Slots>: edge-trigger command with priority arbitration
+    // between concurrent posters (operator / autopilot / safety monitor).
+    //
+    // post(v, prio, source) replaces the pending command only if prio is
+    // higher than or equal to the pending one, and returns false otherwise.
+    // consume() reports the winning source and priority. Once a command is
+    // consumed, the next post of any priority is accepted.
+    //
+    // Lock-free: a poster writes its value into a private slot taken from a
+    // small pool, then installs it with one CAS on a packed state word
+    // {generation, source, prio, slot, pending}. The generation defeats ABA.
+    // A slot is returned to the pool when it is replaced or consumed. Up to
+    // Slots - 2 posters proceed without waiting; beyond that, posters yield
+    // until a slot frees up. An optional tag (e.g. an audit seq) rides in the
+    // slot with the value: consume() returns it, and a post that preempts a
+    // pending command reports the preempted command's tag.
+    template <typename T, std::size_t Slots = 8>
+    class PrioCmdReg
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "PrioCmdReg<T>: T must be trivially copyable (no heap, fast copy).");
+        static_assert(Slots >= 3 && Slots <= 32, "PrioCmdReg: Slots must be in [3, 32]");
+
+    public:
+        inline bool post(const T &v, uint8_t prio = 0, uint16_t source = 0, uint64_t tag = 0,
+                         uint64_t *preempted = nullptr)
+        {
+            uint64_t cur = state_.load(std::memory_order_acquire);
+            if (pending(cur) && prio_of(cur) > prio)
+                return false; // cheap reject before taking a slot
+
+            const uint32_t s = take_slot();
+            slot_[s] = v;
+            tag_[s] = tag;
+            for (;;)
+            {
+                if (pending(cur) && prio_of(cur) > prio)
+                {
+                    give_slot(s);
+                    return false;
+                }
+                const uint64_t next = pack(gen_of(cur) + 1, source, prio, s, true);
+                if (state_.compare_exchange_weak(cur, next, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    if (pending(cur))
+                    {
+                        if (preempted)
+                            *preempted = tag_[slot_of(cur)];
+                        give_slot(slot_of(cur)); // preempted command
+                    }
+                    return true;
+                }
+            }
+        }
+
+        inline bool consume(T &out, uint16_t *source = nullptr, uint8_t *prio = nullptr, uint64_t *tag = nullptr)
+        {
+            uint64_t cur = state_.load(std::memory_order_acquire);
+            for (;;)
+            {
+                if (!pending(cur))
+                    return false;
+                const uint64_t next = pack(gen_of(cur) + 1, 0, 0, 0, false);
+                if (state_.compare_exchange_weak(cur, next, std::memory_order_acq_rel, std::memory_order_acquire))
+                    break;
+            }
+            out = slot_[slot_of(cur)]; // slot is ours until released
+            if (source)
+                *source = source_of(cur);
+            if (prio)
+                *prio = prio_of(cur);
+            if (tag)
+                *tag = tag_[slot_of(cur)];
+            give_slot(slot_of(cur));
+            return true;
+        }
+
+        inline bool pending() const { return pending(state_.load(std::memory_order_acquire)); }
+
+        // Priority of the pending command (meaningful only while pending())
+        inline uint8_t pending_prio() const { return prio_of(state_.load(std::memory_order_acquire)); }
+
+    private:
+        // [63:32] generation | [31:16] source | [15:8] prio | [7:1] slot | [0] pending
+        static constexpr uint64_t pack(uint64_t gen, uint16_t src, uint8_t prio, uint32_t slot, bool p)
+        {
+            return (gen << 32) | (uint64_t(src) << 16) | (uint64_t(prio) << 8) | (uint64_t(slot) << 1) | uint64_t(p);
+        }
+        static constexpr bool pending(uint64_t s) { return s & 1u; }
+        static constexpr uint32_t slot_of(uint64_t s) { return uint32_t(s >> 1) & 0x7Fu; }
+        static constexpr uint8_t prio_of(uint64_t s) { return uint8_t(s >> 8); }
+        static constexpr uint16_t source_of(uint64_t s) { return uint16_t(s >> 16); }
+        static constexpr uint64_t gen_of(uint64_t s) { return s >> 32; }
+
+        static constexpr uint32_t all_free = Slots == 32 ? 0xFFFFFFFFu : (uint32_t(1) << Slots) - 1;
+
+        inline uint32_t take_slot()
+        {
+            uint32_t m = free_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                if (m == 0)
+                {
+                    std::this_thread::yield();
+                    m = free_.load(std::memory_order_relaxed);
+                    continue;
+                }
+                const uint32_t bit = m & (~m + 1);
+                if (free_.compare_exchange_weak(m, m & ~bit, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    uint32_t i = 0;
+                    while (!(bit >> i & 1u))
+                        ++i;
+                    return i;
+                }
+            }
+        }
+        inline void give_slot(uint32_t i) { free_.fetch_or(uint32_t(1) << i, std::memory_order_release); }
+
+        std::atomic<uint64_t> state_{0};
+        std::atomic<uint32_t> free_{all_free};
+        T slot_[Slots]{};
+        uint64_t tag_[Slots]{};
+    };
+} // namespace regbus
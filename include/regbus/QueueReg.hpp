@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace regbus
+{
+    // QueueReg<T, Capacity, Consumers>: bounded MPMC work queue (Vyukov ring)
+    // for a pool of workers that each take the next pending job. Every cell
+    // carries a sequence number; producers and consumers claim positions
+    // with one CAS and never touch each other's cells.
+    //
+    // pop_batch() claims up to max ready cells with a single CAS, so a worker
+    // that drains a burst pays the contended CAS once per batch.
+    // Consumers pass their id (< Consumers) to get per-consumer fairness
+    // counters (items and claims), each on its own cache line.
+    template <typename T, std::size_t Capacity = 64, std::size_t Consumers = 16>
+    class QueueReg
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "QueueReg<T>: T must be trivially copyable (no heap, fast copy).");
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "QueueReg: Capacity must be a power of two");
+        static_assert(Consumers >= 1, "QueueReg: need at least one consumer slot");
+
+    public:
+        static constexpr std::size_t capacity = Capacity;
+        static constexpr std::size_t consumers = Consumers;
+
+        QueueReg()
+        {
+            for (std::size_t i = 0; i < Capacity; ++i)
+                cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        // False when full (counted in rejected())
+        inline bool push(const T &v)
+        {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &c = cells_[pos & mask];
+                const std::size_t seq = c.seq.load(std::memory_order_acquire);
+                const std::intptr_t dif = std::intptr_t(seq) - std::intptr_t(pos);
+                if (dif == 0)
+                {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        c.val = v;
+                        c.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (dif < 0)
+                {
+                    rejected_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        inline bool pop(T &out, std::size_t consumer = 0) { return pop_batch(&out, 1, consumer) == 1; }
+
+        // Claims up to max consecutive ready items with one CAS; returns count
+        inline std::size_t pop_batch(T *out, std::size_t max, std::size_t consumer = 0)
+        {
+            if (max == 0)
+                return 0;
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            std::size_t n;
+            for (;;)
+            {
+                bool raced = false;
+                for (n = 0; n < max && n < Capacity; ++n)
+                {
+                    const std::size_t seq = cells_[(pos + n) & mask].seq.load(std::memory_order_acquire);
+                    const std::intptr_t dif = std::intptr_t(seq) - std::intptr_t(pos + n + 1);
+                    if (dif != 0)
+                    {
+                        raced = dif > 0 && n == 0; // another consumer took pos
+                        break;
+                    }
+                }
+                if (raced)
+                    pos = head_.load(std::memory_order_relaxed);
+                else if (n == 0)
+                    return 0; // empty
+                else if (head_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+                    break;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                Cell &c = cells_[(pos + i) & mask];
+                out[i] = c.val;
+                c.seq.store(pos + i + Capacity, std::memory_order_release);
+            }
+            Stats &s = stats_[consumer < Consumers ? consumer : Consumers - 1];
+            s.items.fetch_add(n, std::memory_order_relaxed);
+            s.claims.fetch_add(1, std::memory_order_relaxed);
+            return n;
+        }
+
+        // Approximate (exact when quiescent)
+        inline std::size_t size() const
+        {
+            const std::size_t t = tail_.load(std::memory_order_acquire);
+            const std::size_t h = head_.load(std::memory_order_acquire);
+            return t > h ? t - h : 0;
+        }
+        inline bool pending() const { return size() != 0; }
+
+        // Fairness statistics
+        inline uint64_t claimed(std::size_t consumer) const { return stats_[consumer].items.load(std::memory_order_relaxed); }
+        inline uint64_t claims(std::size_t consumer) const { return stats_[consumer].claims.load(std::memory_order_relaxed); }
+        inline uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+        inline void reset_stats()
+        {
+            for (auto &s : stats_)
+            {
+                s.items.store(0, std::memory_order_relaxed);
+                s.claims.store(0, std::memory_order_relaxed);
+            }
+            rejected_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::size_t mask = Capacity - 1;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> seq;
+            T val;
+        };
+        struct alignas(64) Stats
+        {
+            std::atomic<uint64_t> items{0};
+            std::atomic<uint64_t> claims{0};
+        };
+
+        alignas(64) std::atomic<std::size_t> tail_{0}; // producers
+        alignas(64) std::atomic<std::size_t> head_{0}; // consumers
+        alignas(64) std::atomic<uint64_t> rejected_{0};
+        alignas(64) Cell cells_[Capacity];
+        Stats stats_[Consumers];
+    };
+} // namespace regbus
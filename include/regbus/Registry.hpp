@@ -1,23 +1,69 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <tuple>
 #include <type_traits>
 #include <cstdint>
+#include <utility>
 
+#include "Alarm.hpp"
+#include "Audit.hpp"
+#include "BitReg.hpp"
+#include "ChunkReg.hpp"
+#include "Config.hpp"
 #include "DBReg.hpp"
 #include "CmdReg.hpp"
+#include "PrioCmdReg.hpp"
+#include "QueueReg.hpp"
+#include "RingReg.hpp"
+#include "StrReg.hpp"
+#include "TensorReg.hpp"
+#include "WaitSet.hpp"
 
 namespace regbus
 {
 
-    // Kind of register (Data = double-buffer latest; Cmd = edge-trigger command)
+    // Kind of register (Data = double-buffer latest; Cmd = edge-trigger command;
+    // Ring = timestamped history of the last Traits::depth samples;
+    // Bits = Traits::bits boolean flags packed into atomic 64-bit words;
+    // Chunked = large single-slot payload published/read per changed chunk;
+    // Queue = bounded MPMC work queue shared by a pool of consumers;
+    // PrioCmd = edge-trigger command where higher/equal priority posts preempt)
     enum class Kind
     {
         Data,
-        Cmd
+        Cmd,
+        Ring,
+        Bits,
+        Chunked,
+        Queue,
+        PrioCmd
     };
 
     // Users provide: template<Key K> struct Traits { using type = ...; static constexpr Kind kind = Kind::Data; }
+    // Data keys may add: using copy = regbus::LargePayloadCopy<>; (see Copy.hpp)
+    // Ring keys may add: static constexpr std::size_t depth = N; (default 16)
+    // Bits keys add:     static constexpr std::size_t bits = N;
+    // Chunked keys may add: static constexpr std::size_t chunk_bytes = N; (default 4096)
+    // Queue keys may add: static constexpr std::size_t capacity = N; (power of two, default 64)
+    //                     static constexpr std::size_t consumers = N; (stats slots, default 16)
+    // PrioCmd keys may add: static constexpr std::size_t slots = N; (value pool, default 8)
+
+    // Registry-wide options: specialize for your key type (all members optional)
+    //   template <> struct regbus::Options<MyKey> {
+    //       static constexpr std::size_t audit_depth = 1024; // command audit ring (default 0 = off)
+    //       static constexpr std::size_t audit_bytes = 16;   // value bytes kept per record
+    //       static constexpr bool generation = true;         // registry-wide change counter (default off)
+    //       static constexpr std::size_t groups = 4;         // per-group counters, keys pick one
+    //                                                        //   with Traits<K>::group (default none)
+    //       static constexpr bool config = true;             // hot-swappable RegistryConfig (default off)
+    //       static constexpr std::size_t config_readers = 16; // ConfigReader slots (see ConfigBlock::refused())
+    //   };
+    template <typename Key>
+    struct Options
+    {
+    };
 
     namespace detail
     {
@@ -54,13 +100,224 @@ namespace regbus
             static constexpr std::size_t value = 0;
         };
 
+        // Optional Traits::depth for Ring keys
+        template <typename Tr, typename = void>
+        struct ring_depth : std::integral_constant<std::size_t, 16>
+        {
+        };
+        template <typename Tr>
+        struct ring_depth<Tr, std::void_t<decltype(Tr::depth)>>
+            : std::integral_constant<std::size_t, Tr::depth>
+        {
+        };
+
+        // Optional Traits::copy policy for Data keys (see Copy.hpp)
+        template <typename Tr, typename = void>
+        struct copy_policy
+        {
+            using type = PlainCopy;
+        };
+        template <typename Tr>
+        struct copy_policy<Tr, std::void_t<typename Tr::copy>>
+        {
+            using type = typename Tr::copy;
+        };
+
+        // Data storage: DBReg, StrReg (length-aware copies) for FixedString,
+        // TensorReg (aligned slots, streaming copies) for Tensor
+        template <typename T, typename Copy>
+        struct data_storage
+        {
+            using type = DBReg<T, Copy>;
+        };
+        template <std::size_t Cap, typename Copy>
+        struct data_storage<FixedString<Cap>, Copy>
+        {
+            using type = StrReg<Cap>;
+        };
+        template <typename T, std::size_t... Dims, typename Copy>
+        struct data_storage<Tensor<T, Dims...>, Copy>
+        {
+            using type = TensorReg<Tensor<T, Dims...>>;
+        };
+
+        // Data types whose storage supports visit(f) on the live slot
+        template <typename T>
+        struct has_visit : std::integral_constant<bool, is_fixed_string<T>::value || is_tensor<T>::value>
+        {
+        };
+
+        // Storage type per kind
+        template <Kind, typename Tr>
+        struct storage_select
+        {
+            using type = typename data_storage<typename Tr::type, typename copy_policy<Tr>::type>::type;
+        };
+        template <typename Tr>
+        struct storage_select<Kind::Cmd, Tr>
+        {
+            using type = CmdReg<typename Tr::type>;
+        };
+        template <typename Tr>
+        struct storage_select<Kind::Ring, Tr>
+        {
+            using type = RingReg<typename Tr::type, ring_depth<Tr>::value>;
+        };
+        template <typename Tr>
+        struct storage_select<Kind::Bits, Tr>
+        {
+            using type = BitReg<Tr::bits>;
+        };
+
+        template <typename Tr, typename = void>
+        struct chunk_bytes : std::integral_constant<std::size_t, 4096>
+        {
+        };
+        template <typename Tr>
+        struct chunk_bytes<Tr, std::void_t<decltype(Tr::chunk_bytes)>>
+            : std::integral_constant<std::size_t, Tr::chunk_bytes>
+        {
+        };
+        template <typename Tr>
+        struct storage_select<Kind::Chunked, Tr>
+        {
+            using type = ChunkReg<typename Tr::type, chunk_bytes<Tr>::value>;
+        };
+
+        template <typename Tr, typename = void>
+        struct queue_capacity : std::integral_constant<std::size_t, 64>
+        {
+        };
+        template <typename Tr>
+        struct queue_capacity<Tr, std::void_t<decltype(Tr::capacity)>>
+            : std::integral_constant<std::size_t, Tr::capacity>
+        {
+        };
+        template <typename Tr, typename = void>
+        struct queue_consumers : std::integral_constant<std::size_t, 16>
+        {
+        };
+        template <typename Tr>
+        struct queue_consumers<Tr, std::void_t<decltype(Tr::consumers)>>
+            : std::integral_constant<std::size_t, Tr::consumers>
+        {
+        };
+        template <typename Tr>
+        struct storage_select<Kind::Queue, Tr>
+        {
+            using type = QueueReg<typename Tr::type, queue_capacity<Tr>::value, queue_consumers<Tr>::value>;
+        };
+
+        template <typename Tr, typename = void>
+        struct prio_slots : std::integral_constant<std::size_t, 8>
+        {
+        };
+        template <typename Tr>
+        struct prio_slots<Tr, std::void_t<decltype(Tr::slots)>>
+            : std::integral_constant<std::size_t, Tr::slots>
+        {
+        };
+        template <typename Tr>
+        struct storage_select<Kind::PrioCmd, Tr>
+        {
+            using type = PrioCmdReg<typename Tr::type, prio_slots<Tr>::value>;
+        };
+
+        // Optional Options::audit_depth / audit_bytes
+        template <typename Opt, typename = void>
+        struct audit_depth : std::integral_constant<std::size_t, 0>
+        {
+        };
+        template <typename Opt>
+        struct audit_depth<Opt, std::void_t<decltype(Opt::audit_depth)>>
+            : std::integral_constant<std::size_t, Opt::audit_depth>
+        {
+        };
+        template <typename Opt, typename = void>
+        struct audit_bytes : std::integral_constant<std::size_t, 16>
+        {
+        };
+        template <typename Opt>
+        struct audit_bytes<Opt, std::void_t<decltype(Opt::audit_bytes)>>
+            : std::integral_constant<std::size_t, Opt::audit_bytes>
+        {
+        };
+        struct no_audit
+        {
+        };
+
+        // Optional Options::generation / groups and Traits::group
+        template <typename Opt, typename = void>
+        struct gen_enabled : std::false_type
+        {
+        };
+        template <typename Opt>
+        struct gen_enabled<Opt, std::void_t<decltype(Opt::generation)>>
+            : std::integral_constant<bool, Opt::generation>
+        {
+        };
+        template <typename Opt, typename = void>
+        struct gen_groups : std::integral_constant<std::size_t, 0>
+        {
+        };
+        template <typename Opt>
+        struct gen_groups<Opt, std::void_t<decltype(Opt::groups)>>
+            : std::integral_constant<std::size_t, Opt::groups>
+        {
+        };
+        template <typename Tr, typename = void>
+        struct has_group : std::false_type
+        {
+        };
+        template <typename Tr>
+        struct has_group<Tr, std::void_t<decltype(Tr::group)>> : std::true_type
+        {
+        };
+
+        // Optional Options::config / config_readers
+        template <typename Opt, typename = void>
+        struct cfg_enabled : std::false_type
+        {
+        };
+        template <typename Opt>
+        struct cfg_enabled<Opt, std::void_t<decltype(Opt::config)>>
+            : std::integral_constant<bool, Opt::config>
+        {
+        };
+        template <typename Opt, typename = void>
+        struct cfg_readers : std::integral_constant<std::size_t, 16>
+        {
+        };
+        template <typename Opt>
+        struct cfg_readers<Opt, std::void_t<decltype(Opt::config_readers)>>
+            : std::integral_constant<std::size_t, Opt::config_readers>
+        {
+        };
+        struct no_config
+        {
+        };
+        struct no_config_reader
+        {
+            struct Scope
+            {
+                template <typename Reg>
+                Scope(no_config_reader &, const Reg &) {}
+                std::nullptr_t get() const { return nullptr; }
+            };
+        };
+
+        // One counter per cache line
+        struct alignas(64) GenCounter
+        {
+            std::atomic<uint64_t> v{0};
+        };
+
         // Select storage type for a key based on Traits::kind<K>
         template <typename Key, template <Key> class Traits, Key K>
         struct storage_for
         {
-            using T = typename Traits<K>::type;
             static constexpr Kind kind = Traits<K>::kind;
-            using type = std::conditional_t<kind == Kind::Cmd, CmdReg<T>, DBReg<T>>;
+            using type = typename storage_select<kind, Traits<K>>::type;
         };
 
     } // namespace detail
@@ -70,34 +327,415 @@ namespace regbus
     class Registry
     {
     public:
+        using key_type = Key;
+        template <Key K>
+        using traits_t = Traits<K>;
         template <Key K>
         using value_t = typename Traits<K>::type;
         template <Key K>
         static constexpr Kind kind = Traits<K>::kind;
 
+        // Compile-time key tag handed to visitors: decltype(tag)::value is the key
+        template <Key K>
+        using key_c = std::integral_constant<Key, K>;
+
         // ---- Data registers (double-buffered latest) ----
-        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data>>
-        inline void write(const value_t<K> &v) { get<K>().write(v); }
+        // write/has/seq also serve Chunked keys (seq = completed writes)
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data || kind<K> == Kind::Chunked>>
+        inline void write(const value_t<K> &v)
+        {
+            get<K>().write(v);
+            on_write<K>();
+            check_alarm<K>(v);
+        }
 
         template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data>>
         inline bool read(value_t<K> &out, uint32_t *seq = nullptr) const { return cget<K>().read(out, seq); }
 
-        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data>>
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data || kind<K> == Kind::Chunked>>
         inline bool has() const { return cget<K>().has(); }
 
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data || kind<K> == Kind::Chunked>>
+        inline uint32_t seq() const { return cget<K>().seq(); }
+
+        // Sleeps until pred(const value_t<K> &) holds for a published value;
+        // evaluated once per publish on the caller (false on timeout; 0 = forever)
+        template <Key K, typename Pred, typename = std::enable_if_t<kind<K> == Kind::Data && !detail::has_visit<value_t<K>>::value>>
+        inline bool wait_until(Pred &&pred, uint64_t timeout_us = 0, value_t<K> *out = nullptr) const
+        {
+            return cget<K>().wait_until(std::forward<Pred>(pred), timeout_us, out);
+        }
+
+        // FixedString keys: write from a string_view
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Data && is_fixed_string<value_t<K>>::value>>
+        inline void write(std::string_view s)
+        {
+            get<K>().write(s);
+            on_write<K>();
+        }
+
+        // FixedString / Tensor keys: f(std::string_view) or f(const Tensor &) on
+        // the live slot, no copy; retried if a write overlaps
+        template <Key K, typename F, typename = std::enable_if_t<kind<K> == Kind::Data && detail::has_visit<value_t<K>>::value>>
+        inline bool visit(F &&f, uint32_t *seq = nullptr) const { return cget<K>().visit(std::forward<F>(f), seq); }
+
+        // Tensor keys: f(Tensor &) computes the next value directly in the back slot
+        template <Key K, typename F, typename = std::enable_if_t<kind<K> == Kind::Data && is_tensor<value_t<K>>::value>>
+        inline void write_in_place(F &&f)
+        {
+            get<K>().write_in_place(std::forward<F>(f));
+            on_write<K>();
+        }
+
         // ---- Command registers (edge-trigger) ----
         template <Key K, typename = std::enable_if_t<kind<K> == Kind::Cmd>>
-        inline void post(const value_t<K> &v) { get<K>().post(v); }
+        inline void post(const value_t<K> &v)
+        {
+            if constexpr (audit_enabled)
+                audit_superseded(get<K>().post(v, audit_post<K>(v)));
+            else
+                get<K>().post(v);
+            on_write<K>();
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Cmd>>
+        inline bool consume(value_t<K> &out)
+        {
+            uint64_t seq = 0;
+            if (!get<K>().consume(out, audit_enabled ? &seq : nullptr))
+                return false;
+            audit_consume(seq);
+            return true;
+        }
+
+        // Blocks until a command arrives (false on timeout; 0 = forever), parked on a futex
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Cmd>>
+        inline bool consume_wait(value_t<K> &out, uint64_t timeout_us = 0)
+        {
+            uint64_t seq = 0;
+            if (!get<K>().consume_wait(out, timeout_us, audit_enabled ? &seq : nullptr))
+                return false;
+            audit_consume(seq);
+            return true;
+        }
 
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Cmd || kind<K> == Kind::Queue || kind<K> == Kind::PrioCmd>>
+        inline bool pending() const { return cget<K>().pending(); }
+
+        // Number of posts so far (wraps): a change means a post, even one already consumed
         template <Key K, typename = std::enable_if_t<kind<K> == Kind::Cmd>>
-        inline bool consume(value_t<K> &out) { return get<K>().consume(out); }
+        inline uint32_t posts() const { return cget<K>().posts(); }
+
+        // ---- Priority commands (lock-free arbitration between posters) ----
+        // Accepted only if prio >= the pending command's; consume reports the winner
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::PrioCmd>>
+        inline bool post(const value_t<K> &v, uint8_t prio = 0, uint16_t source = 0)
+        {
+            if constexpr (audit_enabled)
+            {
+                // The record must exist before the command can be consumed.
+                // Posts rejected up front are not audited; one that loses a
+                // race after being recorded is marked superseded.
+                if (cget<K>().pending() && cget<K>().pending_prio() > prio)
+                    return false;
+                const uint64_t seq = audit_post<K>(v);
+                uint64_t preempted = 0;
+                if (!get<K>().post(v, prio, source, seq, &preempted))
+                {
+                    audit_superseded(seq);
+                    return false;
+                }
+                audit_superseded(preempted);
+            }
+            else if (!get<K>().post(v, prio, source))
+                return false;
+            on_write<K>();
+            return true;
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::PrioCmd>>
+        inline bool consume(value_t<K> &out, uint16_t *source = nullptr, uint8_t *prio = nullptr)
+        {
+            uint64_t seq = 0;
+            if (!get<K>().consume(out, source, prio, audit_enabled ? &seq : nullptr))
+                return false;
+            audit_consume(seq);
+            return true;
+        }
+
+        // ---- Queue registers (MPMC work queue, any number of producers/consumers) ----
+        // push() returns false when full; consumer ids (< Traits::consumers) feed fairness stats
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Queue>>
+        inline bool push(const value_t<K> &v)
+        {
+            if (!get<K>().push(v))
+                return false;
+            on_write<K>();
+            return true;
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Queue>>
+        inline bool pop(value_t<K> &out, std::size_t consumer = 0) { return get<K>().pop(out, consumer); }
+
+        // Claims up to max items with one CAS; returns count
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Queue>>
+        inline std::size_t pop_batch(value_t<K> *out, std::size_t max, std::size_t consumer = 0)
+        {
+            return get<K>().pop_batch(out, max, consumer);
+        }
+
+        // Stats access (size(), claimed(c), claims(c), rejected(), reset_stats())
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Queue>>
+        inline auto &queue() { return get<K>(); }
+
+        // ---- Ring registers (timestamped history) ----
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Ring>>
+        inline void write(uint64_t t, const value_t<K> &v)
+        {
+            get<K>().write(t, v);
+            on_write<K>();
+            check_alarm<K>(v);
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Ring>>
+        inline bool latest(value_t<K> &out, uint64_t *t = nullptr) const { return cget<K>().latest(out, t); }
+
+        // Bracketing samples, or the value interpolated at t (Lerp or user f(a, b, alpha))
+        template <Key K>
+        using bracket_t = typename detail::storage_for<Key, Traits, K>::type::Bracket;
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Ring>>
+        inline At read_at(uint64_t t, bracket_t<K> &out) const { return cget<K>().read_at(t, out); }
+
+        template <Key K, typename Interp = Lerp, typename = std::enable_if_t<kind<K> == Kind::Ring>>
+        inline At read_at(uint64_t t, value_t<K> &out, Interp &&interp = Interp{}) const
+        {
+            return cget<K>().read_at(t, out, std::forward<Interp>(interp));
+        }
+
+        // Direct access for cursors (count(), oldest(), at(idx, t, &v))
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Ring>>
+        inline const auto &history() const { return cget<K>(); }
+
+        // ---- Bit registers (packed flags; i in [0, Traits::bits)) ----
+        // set/clear/toggle return the previous value of the flag; a set or
+        // clear that changes nothing (or i out of range) notifies nobody
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Bits>>
+        inline bool set(std::size_t i)
+        {
+            const bool was = get<K>().set(i);
+            if (!was && i < Traits<K>::bits)
+                on_write<K>();
+            return was;
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Bits>>
+        inline bool clear(std::size_t i)
+        {
+            const bool was = get<K>().clear(i);
+            if (was)
+                on_write<K>();
+            return was;
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Bits>>
+        inline bool toggle(std::size_t i)
+        {
+            const bool was = get<K>().toggle(i);
+            if (i < Traits<K>::bits)
+                on_write<K>();
+            return was;
+        }
+
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Bits>>
+        inline bool test(std::size_t i) const { return cget<K>().test(i); }
+
+        // Bulk access (snapshot(), any(), count(), find_first())
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Bits>>
+        inline const auto &flags() const { return cget<K>(); }
+
+        // ---- Chunked registers (large payloads, per-chunk change tracking) ----
+        // Per-reader cursor: last sequence seen per chunk
+        template <Key K>
+        using cursor_t = typename detail::storage_for<Key, Traits, K>::type::Cursor;
+
+        // False (nothing written) if [off, off + n) runs past the payload
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Chunked>>
+        inline bool write_bytes(std::size_t off, const void *src, std::size_t n)
+        {
+            if (!get<K>().write_bytes(off, src, n))
+                return false;
+            on_write<K>();
+            return true;
+        }
+
+        // Copies only chunks changed since cur; returns chunks copied
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Chunked>>
+        inline std::size_t read_changed(value_t<K> &out, cursor_t<K> &cur) const { return cget<K>().read_changed(out, cur); }
+
+        // Same, repeated until no write() overlapped: a complete frame
+        template <Key K, typename = std::enable_if_t<kind<K> == Kind::Chunked>>
+        inline std::size_t read_frame(value_t<K> &out, cursor_t<K> &cur) const { return cget<K>().read_frame(out, cur); }
+
+        // ---- Wait sets (block until any / all of several keys change) ----
+        // Data, Bits and Cmd keys; Cmd keys fire while a command is pending.
+        // Writers pay one load, plus one RMW and a wake only while waiters exist.
+        using wait_set_t = WaitSet<sizeof...(Keys)>;
+
+        template <Key K>
+        static constexpr bool waitable = kind<K> == Kind::Data || kind<K> == Kind::Bits || kind<K> == Kind::Cmd;
+
+        // Set watching Ks..., cursors at the current values (fires on the next change)
+        template <Key... Ks>
+        inline wait_set_t wait_set() const
+        {
+            static_assert((waitable<Ks> && ...), "wait_set<Ks...>: only Data, Bits and Cmd keys can be waited on");
+            wait_set_t ws;
+            (watch(ws, idx<Ks>()), ...);
+            return ws;
+        }
+
+        // Runtime form: watch key index i (false if its kind is not waitable)
+        inline bool watch(wait_set_t &ws, std::size_t i) const
+        {
+            if (i >= sizeof...(Keys) || !stamp_at(i))
+                return false;
+            ws.mask_[i / 64] |= uint64_t(1) << (i % 64);
+            ws.seen_[i] = stamp_at(i)(*this).published;
+            return true;
+        }
+
+        // Blocks until a watched key changes (true; see ws.fired()) or the
+        // timeout passes (false; 0 = forever). Fired cursors advance.
+        inline bool wait_any(wait_set_t &ws, uint64_t timeout_us = 0) const { return wait_for<false>(ws, timeout_us); }
+
+        // Same, until every watched key has changed since its cursor
+        inline bool wait_all(wait_set_t &ws, uint64_t timeout_us = 0) const { return wait_for<true>(ws, timeout_us); }
+
+        // ---- Generation counters (Options<Key>::generation / groups) ----
+        // Bumped (release) after every write/post/set; compare against the last
+        // value seen to skip a whole scan when nothing changed.
+        static constexpr bool has_generation = detail::gen_enabled<Options<Key>>::value;
+        static constexpr std::size_t generation_groups = detail::gen_groups<Options<Key>>::value;
+
+        inline uint64_t generation() const
+        {
+            static_assert(has_generation, "generation(): set Options<Key>::generation = true");
+            return gen_[0].v.load(std::memory_order_acquire);
+        }
+
+        inline uint64_t generation(std::size_t group) const
+        {
+            static_assert(generation_groups > 0, "generation(group): set Options<Key>::groups");
+            return gen_[group_base + group].v.load(std::memory_order_acquire);
+        }
+
+        // ---- Runtime configuration (Options<Key>::config) ----
+        // Bridge / record / rate-limit policy per key, swapped while producers
+        // and consumers run (see Config.hpp). Components with a config_reader_t
+        // (SyncCursor, Packer, CompressingRecorder) pick it up each cycle.
+        static constexpr bool has_config = detail::cfg_enabled<Options<Key>>::value;
+        using config_t = RegistryConfig<sizeof...(Keys)>;
+        using config_block_t = ConfigBlock<sizeof...(Keys), detail::cfg_readers<Options<Key>>::value>;
+        using config_reader_t = std::conditional_t<has_config, ConfigReader<config_block_t>, detail::no_config_reader>;
+
+        // edit(config_t &) on a copy of the live config, then one swap.
+        // Waits (up to timeout_us, 0 = forever) only for readers of the config
+        // before last; never for writers or current readers.
+        template <typename F>
+        inline bool reconfigure(F &&edit, uint64_t timeout_us = 0)
+        {
+            static_assert(has_config, "reconfigure(): set Options<Key>::config = true");
+            return config_.update(std::forward<F>(edit), timeout_us);
+        }
+
+        // Same, never waits: false while the spare buffer may still be read
+        template <typename F>
+        inline bool try_reconfigure(F &&edit)
+        {
+            static_assert(has_config, "try_reconfigure(): set Options<Key>::config = true");
+            return config_.try_update(std::forward<F>(edit));
+        }
+
+        // For ConfigReader::enter / Scope (reader bookkeeping is internal to the block)
+        inline const config_block_t &config_block() const
+        {
+            static_assert(has_config, "config_block(): set Options<Key>::config = true");
+            return config_;
+        }
+
+        // ---- Alarms (keys with Traits::alarm_hi / alarm_lo, checked in write) ----
+        template <Key K>
+        inline AlarmLevel alarm() const
+        {
+            static_assert(detail::has_alarm<Traits<K>>::value, "alarm<K>: K has no alarm limits");
+            constexpr uint64_t bit = uint64_t(1) << (idx<K>() % 64);
+            if (alarm_hi_[idx<K>() / 64].load(std::memory_order_acquire) & bit)
+                return AlarmLevel::High;
+            if (alarm_lo_[idx<K>() / 64].load(std::memory_order_acquire) & bit)
+                return AlarmLevel::Low;
+            return AlarmLevel::None;
+        }
+
+        // Bit index<K>() % 64 of word index<K>() / 64 is set while K is in alarm
+        static constexpr std::size_t alarm_words() { return n_alarm_words; }
+        inline uint64_t alarm_word(std::size_t i) const
+        {
+            return alarm_hi_[i].load(std::memory_order_acquire) | alarm_lo_[i].load(std::memory_order_acquire);
+        }
+
+        inline bool any_alarm() const
+        {
+            for (std::size_t i = 0; i < n_alarm_words; ++i)
+                if (alarm_word(i))
+                    return true;
+            return false;
+        }
+
+        inline std::size_t alarm_count() const
+        {
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < n_alarm_words; ++i)
+                n += detail::popcount64(alarm_word(i));
+            return n;
+        }
+
+        // ---- Command audit (Options<Key>::audit_depth > 0) ----
+        // Every Cmd / accepted PrioCmd post with time, poster thread and value
+        // bytes; consume time is filled in when the post is consumed, and
+        // posts replaced while pending are marked superseded.
+        static constexpr bool audit_enabled = detail::audit_depth<Options<Key>>::value > 0;
+        using audit_t = AuditRing<detail::audit_depth<Options<Key>>::value ? detail::audit_depth<Options<Key>>::value : 1,
+                                  detail::audit_bytes<Options<Key>>::value>;
+        using audit_record_t = typename audit_t::record_type;
+
+        // dump(f(const audit_record_t &)), recorded()
+        inline const audit_t &audit() const
+        {
+            static_assert(audit_enabled, "audit(): set Options<Key>::audit_depth to enable");
+            return audit_;
+        }
 
         // Size accounting (compile-time, useful for budgets)
         static constexpr std::size_t bytes() { return sizeof(Registry); }
 
+        // ---- Key introspection (compile-time) ----
+        static constexpr std::size_t size() { return sizeof...(Keys); }
+
+        template <Key K>
+        static constexpr std::size_t index() { return detail::index_of<Key, K, Keys...>::value; }
+
+        // std::tuple<Slot<K>...> over the key list, for per-key side storage
+        template <template <Key> class Slot>
+        using per_key_t = std::tuple<Slot<Keys>...>;
+
+        // Calls f(key_c<K>{}) for every key, in key-list order (constexpr-friendly)
+        template <typename F>
+        static constexpr void for_each_key(F &&f) { (f(key_c<Keys>{}), ...); }
+
     private:
         template <Key K>
-        static constexpr std::size_t idx() { return detail::index_of<Key, K, Keys...>::value; }
+        static constexpr std::size_t idx() { return index<K>(); }
 
         template <Key K>
         using storage_t = typename detail::storage_for<Key, Traits, K>::type;
@@ -107,8 +745,206 @@ namespace regbus
         template <Key K>
         inline const storage_t<K> &cget() const { return std::get<idx<K>()>(storage_); }
 
+        using stamp_fn = WaitStamp (*)(const Registry &);
+
+        // Per-index stamp reader; nullptr for kinds that cannot be waited on
+        static stamp_fn stamp_at(std::size_t i)
+        {
+            static constexpr stamp_fn table[] = {(waitable<Keys> ? &Registry::stamp_of<Keys> : nullptr)...};
+            return table[i];
+        }
+        template <Key K>
+        static WaitStamp stamp_of(const Registry &r)
+        {
+            if constexpr (waitable<K>)
+                return r.cget<K>().stamp();
+            else
+                return WaitStamp{0, 0};
+        }
+        static bool level_at(std::size_t i)
+        {
+            static constexpr bool table[] = {(kind<Keys> == Kind::Cmd)...};
+            return table[i];
+        }
+
+        // Every mutator ends here: generation bumps, then wait-set wakeups
+        template <Key K>
+        inline void on_write()
+        {
+            if constexpr (has_generation)
+                gen_[0].v.fetch_add(1, std::memory_order_release);
+            if constexpr (detail::has_group<Traits<K>>::value)
+            {
+                static_assert(Traits<K>::group < generation_groups, "Traits<K>::group must be < Options<Key>::groups");
+                gen_[group_base + Traits<K>::group].v.fetch_add(1, std::memory_order_release);
+            }
+            // Pairs with the waiter's announce in wait_for: the store side's
+            // seq_cst RMW precedes this load, so a missed waiter sees the write
+            if constexpr (waitable<K>)
+                if (wake_.waiters.load(std::memory_order_seq_cst))
+                {
+                    wake_.word.fetch_add(1, std::memory_order_release);
+                    futex_wake_all(wake_.word);
+                }
+        }
+
+        template <bool All>
+        inline bool wait_for(wait_set_t &ws, uint64_t timeout_us) const
+        {
+            constexpr std::size_t n = sizeof...(Keys);
+            const uint64_t deadline = timeout_us ? detail::steady_us() + timeout_us : 0;
+            wake_.waiters.fetch_add(1, std::memory_order_seq_cst);
+            struct Leave
+            {
+                std::atomic<uint32_t> &w;
+                ~Leave() { w.fetch_sub(1, std::memory_order_relaxed); }
+            } leave{wake_.waiters};
+
+            std::array<uint32_t, n> pub{};
+            uint32_t spins = 0;
+            for (;;)
+            {
+                const uint32_t e = wake_.word.load(std::memory_order_acquire);
+                bool any = false, all = true, inflight = false;
+                for (std::size_t w = 0; w < ws.words; ++w)
+                {
+                    ws.fired_[w] = 0;
+                    for (uint64_t m = ws.mask_[w]; m; m &= m - 1)
+                    {
+                        const std::size_t i = w * 64 + std::size_t(detail::ctz64(m));
+                        const WaitStamp st = stamp_at(i)(*this);
+                        pub[i] = st.published;
+                        if (level_at(i) ? st.published != 0 : st.published != ws.seen_[i])
+                        {
+                            ws.fired_[w] |= uint64_t(1) << (i % 64);
+                            any = true;
+                        }
+                        else
+                        {
+                            all = false;
+                            inflight |= st.started != st.published;
+                        }
+                    }
+                }
+                if (any && (!All || all))
+                {
+                    ws.for_each_fired([&](std::size_t i)
+                                      { ws.seen_[i] = pub[i]; });
+                    return true;
+                }
+
+                uint64_t left = 0;
+                if (deadline)
+                {
+                    const uint64_t now = detail::steady_us();
+                    if (now >= deadline)
+                        return false;
+                    left = deadline - now;
+                }
+                if (inflight)
+                {
+                    // A write is mid-publish and may have missed our announce
+                    if (++spins < 64)
+                        std::this_thread::yield();
+                    else
+                        futex_wait(wake_.word, e, left && left < 50 ? left : 50);
+                    continue;
+                }
+                spins = 0;
+                futex_wait(wake_.word, e, left);
+            }
+        }
+
+        // Limit check on the write path; compiles away for keys without limits.
+        // Steady state is one relaxed load per word and two compares; the
+        // bitmaps are only written (and the edge posted) when the state flips.
+        template <Key K>
+        inline void check_alarm(const value_t<K> &v)
+        {
+            if constexpr (detail::has_alarm<Traits<K>>::value)
+            {
+                constexpr std::size_t w = idx<K>() / 64;
+                constexpr uint64_t bit = uint64_t(1) << (idx<K>() % 64);
+                const bool in_hi = alarm_hi_[w].load(std::memory_order_relaxed) & bit;
+                const bool in_lo = alarm_lo_[w].load(std::memory_order_relaxed) & bit;
+                bool hi, lo;
+                detail::alarm_eval<Traits<K>>(v, in_hi, in_lo, hi, lo);
+                if (hi == in_hi && lo == in_lo)
+                    return;
+
+                bool edge = false;
+                if (hi != in_hi)
+                    edge |= flip(alarm_hi_[w], bit, hi);
+                if (lo != in_lo)
+                    edge |= flip(alarm_lo_[w], bit, lo);
+                if constexpr (detail::has_alarm_cmd<Traits<K>>::value)
+                {
+                    constexpr Key C = Traits<K>::alarm_cmd;
+                    static_assert(kind<C> == Kind::Cmd && std::is_same<value_t<C>, AlarmEvent>::value,
+                                  "Traits::alarm_cmd must name a Cmd key of type AlarmEvent");
+                    if (edge)
+                        post<C>(AlarmEvent{uint16_t(idx<K>()), hi ? AlarmLevel::High : lo ? AlarmLevel::Low : AlarmLevel::None});
+                }
+            }
+        }
+
+        // Audit seqs travel with the command in its register slot (0 = none)
+        template <Key K>
+        inline uint64_t audit_post(const value_t<K> &v)
+        {
+            if constexpr (audit_enabled)
+                return audit_.posted(uint16_t(idx<K>()), &v, sizeof v);
+            else
+                return 0;
+        }
+        inline void audit_consume(uint64_t seq)
+        {
+            if constexpr (audit_enabled)
+                if (seq)
+                    audit_.consumed(seq);
+        }
+        inline void audit_superseded(uint64_t seq)
+        {
+            if constexpr (audit_enabled)
+                if (seq)
+                    audit_.superseded(seq);
+        }
+
+        // True if this call changed the bit (concurrent writers: one edge only)
+        static inline bool flip(std::atomic<uint64_t> &word, uint64_t bit, bool on)
+        {
+            const uint64_t old = on ? word.fetch_or(bit, std::memory_order_acq_rel)
+                                    : word.fetch_and(~bit, std::memory_order_acq_rel);
+            return ((old & bit) != 0) != on;
+        }
+
+        static constexpr bool has_alarm_keys = (detail::has_alarm<Traits<Keys>>::value || ...);
+        static constexpr std::size_t n_alarm_words = has_alarm_keys ? (sizeof...(Keys) + 63) / 64 : 0;
+
         // One storage member per key (type-selected at compile time)
         std::tuple<storage_t<Keys>...> storage_;
+
+        // Alarm bitmaps (empty unless some key has limits)
+        std::array<std::atomic<uint64_t>, n_alarm_words> alarm_hi_{};
+        std::array<std::atomic<uint64_t>, n_alarm_words> alarm_lo_{};
+
+        // Generation counters: [0] registry-wide (if enabled), then groups
+        static constexpr std::size_t group_base = has_generation ? 1 : 0;
+        std::array<detail::GenCounter, group_base + generation_groups> gen_{};
+
+        // Shared wakeup word for wait sets (own line: bumped only with waiters)
+        struct alignas(64) Wake
+        {
+            std::atomic<uint32_t> word{0};
+            std::atomic<uint32_t> waiters{0};
+        };
+        mutable Wake wake_;
+
+        // Command audit (empty unless enabled)
+        std::conditional_t<audit_enabled, audit_t, detail::no_audit> audit_;
+
+        // Runtime configuration (empty unless enabled)
+        std::conditional_t<has_config, config_block_t, detail::no_config> config_;
     };
 
 } // namespace regbus
\ No newline at end of file
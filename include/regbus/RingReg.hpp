@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace regbus
+{
+    // Result of a timestamp lookup in a RingReg
+    enum class At : uint8_t
+    {
+        Ok,     // bracket found (t0 <= t <= t1)
+        Before, // t is older than the oldest retained sample
+        After,  // t is newer than the newest sample
+        Empty   // nothing written yet
+    };
+
+    // Default interpolator for arithmetic types: a + (b - a) * alpha.
+    // Integral types are computed in double (b - a may be negative for
+    // unsigned T) and rounded to nearest.
+    struct Lerp
+    {
+        template <typename T>
+        T operator()(const T &a, const T &b, double alpha) const
+        {
+            static_assert(std::is_arithmetic<T>::value,
+                          "Lerp: pass a custom interpolator f(a, b, alpha) for non-arithmetic T");
+            if constexpr (std::is_floating_point<T>::value)
+                return static_cast<T>(a + (b - a) * alpha);
+            else
+                return static_cast<T>(std::floor(double(a) + (double(b) - double(a)) * alpha + 0.5));
+        }
+    };
+
+    // RingReg<T, N>: timestamped short history (last N samples).
+    //
+    // One writer pushes (t, value) with non-decreasing timestamps; any number
+    // of readers take coherent snapshots of the latest sample, of any retained
+    // sample by absolute index, or of the two samples bracketing a timestamp
+    // (binary search over the ring: O(log N), no copy of the ring).
+    // Each slot carries a stamp (odd while being written, 2*idx+2 once sample
+    // idx is complete), so readers detect torn or overwritten slots and retry.
+    template <typename T, std::size_t N>
+    class RingReg
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "RingReg<T>: T must be trivially copyable (no heap, fast copy).");
+        static_assert(N >= 2, "RingReg: N must be >= 2");
+
+    public:
+        static constexpr std::size_t depth = N;
+
+        struct Bracket
+        {
+            uint64_t t0, t1; // t0 <= t <= t1 (equal on an exact hit)
+            T v0, v1;
+        };
+
+        inline void write(uint64_t t, const T &v)
+        {
+            const uint64_t idx = head_.load(std::memory_order_relaxed);
+            Slot &s = slots_[idx % N];
+            s.stamp.store(1, std::memory_order_relaxed); // odd: in progress
+            std::atomic_thread_fence(std::memory_order_release);
+            s.t = t;
+            s.v = v;
+            s.stamp.store(stamp(idx), std::memory_order_release);
+            head_.store(idx + 1, std::memory_order_release);
+        }
+
+        // Total samples written (next absolute index)
+        inline uint64_t count() const { return head_.load(std::memory_order_acquire); }
+        inline bool has() const { return count() != 0; }
+
+        // Oldest absolute index still (nominally) retained
+        inline uint64_t oldest() const
+        {
+            const uint64_t h = count();
+            return h > N ? h - N : 0;
+        }
+
+        // Coherent read of sample idx; false if never written or overwritten
+        inline bool at(uint64_t idx, uint64_t &t, T *v = nullptr) const
+        {
+            const Slot &s = slots_[idx % N];
+            const uint32_t a = s.stamp.load(std::memory_order_acquire);
+            if (a != stamp(idx))
+                return false;
+            uint64_t tt = s.t;
+            if (v)
+            {
+                T tmp = s.v;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.stamp.load(std::memory_order_relaxed) != a)
+                    return false;
+                *v = tmp;
+            }
+            else
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.stamp.load(std::memory_order_relaxed) != a)
+                    return false;
+            }
+            t = tt;
+            return true;
+        }
+
+        inline bool latest(T &out, uint64_t *t = nullptr) const
+        {
+            for (;;)
+            {
+                const uint64_t h = count();
+                if (!h)
+                    return false;
+                uint64_t tt;
+                if (at(h - 1, tt, &out))
+                {
+                    if (t)
+                        *t = tt;
+                    return true;
+                }
+            }
+        }
+
+        // Samples bracketing t
+        At read_at(uint64_t t, Bracket &out) const
+        {
+            for (;;)
+            {
+                const uint64_t h = count();
+                if (!h)
+                    return At::Empty;
+                uint64_t lo = h > N ? h - N : 0, hi = h - 1, tt;
+
+                // Newest first: the common "value at a recent time" case
+                if (!at(hi, tt))
+                    continue;
+                if (t > tt)
+                    return At::After;
+
+                // Oldest still readable (skip slots the writer is lapping)
+                while (lo < hi && !at(lo, tt))
+                    ++lo;
+                if (!at(lo, tt))
+                    continue;
+                if (t < tt)
+                    return At::Before;
+
+                // Invariant: ts(lo) <= t <= ts(hi); find adjacent pair
+                bool lapped = false;
+                while (hi - lo > 1)
+                {
+                    const uint64_t mid = lo + (hi - lo) / 2;
+                    if (!at(mid, tt))
+                    {
+                        lapped = true;
+                        break;
+                    }
+                    (tt <= t ? lo : hi) = mid;
+                }
+                if (lapped || !at(lo, out.t0, &out.v0) || !at(hi, out.t1, &out.v1))
+                    continue;
+                if (out.t0 == t) // exact hit
+                {
+                    out.t1 = out.t0;
+                    out.v1 = out.v0;
+                }
+                else if (out.t1 == t)
+                {
+                    out.t0 = out.t1;
+                    out.v0 = out.v1;
+                }
+                return At::Ok;
+            }
+        }
+
+        // Value at t, interpolated between the bracketing samples
+        template <typename Interp = Lerp>
+        At read_at(uint64_t t, T &out, Interp &&interp = Interp{}) const
+        {
+            Bracket b;
+            const At r = read_at(t, b);
+            if (r != At::Ok)
+                return r;
+            if (b.t0 == b.t1)
+                out = b.v0;
+            else
+                out = interp(b.v0, b.v1, double(t - b.t0) / double(b.t1 - b.t0));
+            return At::Ok;
+        }
+
+    private:
+        static constexpr uint32_t stamp(uint64_t idx) { return uint32_t(2 * idx + 2); }
+
+        struct Slot
+        {
+            std::atomic<uint32_t> stamp{0};
+            uint64_t t = 0;
+            T v{};
+        };
+
+        alignas(64) std::atomic<uint64_t> head_{0};
+        Slot slots_[N];
+    };
+} // namespace regbus
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Futex.hpp"
+
+namespace regbus
+{
+    // SeqBuffer<T>: the double-buffer/seq protocol shared by DBReg, StrReg and
+    // TensorReg. One writer fills back() and publish()es it: a seq_cst RMW on
+    // the counter, then the slot's seq, the index flip and has (release).
+    // Readers visit() the live slot and retry until no publish overlapped.
+    // Slots are at least 16-byte aligned (more if T asks for it).
+    template <typename T>
+    class SeqBuffer
+    {
+    public:
+        SeqBuffer() : idx_(0), has_(false)
+        {
+            seq_[0].store(0);
+            seq_[1].store(0);
+        }
+
+        // Writer: the slot readers are not on (previous contents unspecified)
+        inline T &back() { return buf_[idx_.load(std::memory_order_acquire) ^ 1u]; }
+
+        // Writer: publishes back(). before(seq) runs right after the counter
+        // RMW, before the slot becomes visible (DBReg checks its waiters here).
+        template <typename F>
+        inline uint32_t publish(F &&before)
+        {
+            const uint32_t nxt = idx_.load(std::memory_order_relaxed) ^ 1u;
+            const uint32_t s = seq_ctr_.fetch_add(1, std::memory_order_seq_cst) + 1;
+            before(s);
+            seq_[nxt].store(s, std::memory_order_release);
+            idx_.store(nxt, std::memory_order_release);
+            has_.store(true, std::memory_order_release);
+            return s;
+        }
+        inline uint32_t publish()
+        {
+            return publish([](uint32_t) {});
+        }
+
+        // Calls f(const T &) on the live slot until a pass completes with no
+        // publish in between; f may run more than once and the reference is
+        // only valid inside f. False if never published.
+        template <typename F>
+        inline bool visit(F &&f, uint32_t *out_seq = nullptr) const
+        {
+            if (!has_.load(std::memory_order_acquire))
+                return false;
+            for (;;)
+            {
+                const uint32_t i1 = idx_.load(std::memory_order_acquire);
+                const uint32_t s1 = seq_[i1].load(std::memory_order_acquire);
+                f(static_cast<const T &>(buf_[i1]));
+                const uint32_t i2 = idx_.load(std::memory_order_acquire);
+                if (i1 == i2 && s1 == seq_[i1].load(std::memory_order_acquire))
+                {
+                    if (out_seq)
+                        *out_seq = s1;
+                    return true;
+                }
+            }
+        }
+
+        inline bool has() const { return has_.load(std::memory_order_acquire); }
+
+        // Sequence of the latest publish started (0 = never)
+        inline uint32_t seq() const { return seq_ctr_.load(std::memory_order_acquire); }
+
+        inline WaitStamp stamp() const
+        {
+            const uint32_t s = seq_ctr_.load(std::memory_order_seq_cst);
+            return {s, seq_[idx_.load(std::memory_order_acquire)].load(std::memory_order_acquire)};
+        }
+
+        // The counter word, for futex waits on publishes
+        inline std::atomic<uint32_t> &counter() { return seq_ctr_; }
+        inline const std::atomic<uint32_t> &counter() const { return seq_ctr_; }
+
+    private:
+        static constexpr std::size_t align = alignof(T) > 16 ? alignof(T) : 16;
+
+        alignas(align) T buf_[2]{}; // avoid false sharing / misalignment
+        std::atomic<uint32_t> seq_[2];
+        std::atomic<uint32_t> seq_ctr_{0};
+        std::atomic<uint32_t> idx_;
+        std::atomic<bool> has_;
+    };
+} // namespace regbus
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace regbus
+{
+    // SpscRing<T, N>: bounded lock-free single-producer/single-consumer ring.
+    // One thread calls try_push(), one thread calls try_pop(); neither blocks.
+    // N must be a power of two. Producer and consumer indices live on their
+    // own cache lines, and each side caches the other's index to avoid
+    // touching the shared line on every call.
+    template <typename T, std::size_t N>
+    class SpscRing
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SpscRing<T>: T must be trivially copyable.");
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing: N must be a power of two");
+
+    public:
+        static constexpr std::size_t capacity = N;
+
+        inline bool try_push(const T &v)
+        {
+            const uint32_t h = head_.load(std::memory_order_relaxed);
+            if (h - tail_cache_ == N)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (h - tail_cache_ == N)
+                    return false; // full
+            }
+            buf_[h & (N - 1)] = v;
+            head_.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        inline bool try_pop(T &out)
+        {
+            const uint32_t t = tail_.load(std::memory_order_relaxed);
+            if (t == head_cache_)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (t == head_cache_)
+                    return false; // empty
+            }
+            out = buf_[t & (N - 1)];
+            tail_.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // All-or-nothing: n elements, published to the consumer together, so a
+        // record split over several elements is never seen half-written
+        inline bool try_push(const T *v, std::size_t n)
+        {
+            const uint32_t h = head_.load(std::memory_order_relaxed);
+            if (N - (h - tail_cache_) < n)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (N - (h - tail_cache_) < n)
+                    return false; // not enough room
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                buf_[(h + uint32_t(i)) & (N - 1)] = v[i];
+            head_.store(h + uint32_t(n), std::memory_order_release);
+            return true;
+        }
+
+        // All-or-nothing: n elements, or false if fewer are available
+        inline bool try_pop(T *out, std::size_t n)
+        {
+            const uint32_t t = tail_.load(std::memory_order_relaxed);
+            if (head_cache_ - t < n)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (head_cache_ - t < n)
+                    return false;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = buf_[(t + uint32_t(i)) & (N - 1)];
+            tail_.store(t + uint32_t(n), std::memory_order_release);
+            return true;
+        }
+
+        // Approximate (exact when called from either endpoint while the other is idle)
+        inline std::size_t size() const
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+        inline bool empty() const { return size() == 0; }
+
+    private:
+        alignas(64) std::atomic<uint32_t> head_{0}; // written by producer
+        uint32_t tail_cache_ = 0;                    // producer's view of tail_
+        alignas(64) std::atomic<uint32_t> tail_{0}; // written by consumer
+        uint32_t head_cache_ = 0;                    // consumer's view of head_
+        alignas(64) T buf_[N];
+    };
+} // namespace regbus
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "Futex.hpp"
+#include "SeqBuffer.hpp"
+
+namespace regbus
+{
+    // FixedString<Cap>: inline string of at most Cap bytes plus its length.
+    // Trivially copyable, no heap; longer input is truncated. Not
+    // NUL-terminated: use view() / size().
+    template <std::size_t Cap>
+    struct FixedString
+    {
+        static_assert(Cap > 0 && Cap <= 0xFFFFFFFFu, "FixedString: bad capacity");
+        static constexpr std::size_t capacity = Cap;
+
+        uint32_t len;
+        char data[Cap];
+
+        FixedString() : len(0) {}
+        explicit FixedString(std::string_view s) { assign(s); }
+
+        inline void assign(std::string_view s)
+        {
+            len = uint32_t(s.size() < Cap ? s.size() : Cap);
+            std::memcpy(data, s.data(), len);
+        }
+
+        inline std::string_view view() const { return std::string_view(data, len); }
+        inline std::size_t size() const { return len; }
+        inline bool empty() const { return len == 0; }
+
+        friend bool operator==(const FixedString &a, const FixedString &b) { return a.view() == b.view(); }
+        friend bool operator!=(const FixedString &a, const FixedString &b) { return !(a == b); }
+    };
+
+    template <typename T>
+    struct is_fixed_string : std::false_type
+    {
+    };
+    template <std::size_t Cap>
+    struct is_fixed_string<FixedString<Cap>> : std::true_type
+    {
+    };
+
+    // StrReg<Cap>: DBReg for FixedString<Cap> that moves only len bytes.
+    // Same double-buffer/seq protocol as DBReg (SeqBuffer); a 10-character
+    // status line in a 256-byte register costs a 14-byte copy instead of 260.
+    template <std::size_t Cap>
+    class StrReg
+    {
+    public:
+        using value_type = FixedString<Cap>;
+
+        inline void write(std::string_view s)
+        {
+            value_type &b = slots_.back();
+            const uint32_t n = uint32_t(s.size() < Cap ? s.size() : Cap);
+            std::memcpy(b.data, s.data(), n);
+            b.len = n;
+            slots_.publish();
+        }
+        inline void write(const value_type &v) { write(v.view()); }
+
+        inline bool read(value_type &out, uint32_t *out_seq = nullptr) const
+        {
+            return visit([&](std::string_view s)
+                         { out.assign(s); }, out_seq);
+        }
+
+        // Calls f(std::string_view) on the live slot without copying it out.
+        // f may run again if the writer overlapped; the view is only valid
+        // inside f. Returns false if never written.
+        template <typename F>
+        inline bool visit(F &&f, uint32_t *out_seq = nullptr) const
+        {
+            // A torn len is only caught after f ran: clamp it
+            return slots_.visit([&](const value_type &b)
+                                {
+                const uint32_t n = b.len;
+                f(std::string_view(b.data, n < Cap ? n : Cap)); },
+                                out_seq);
+        }
+
+        inline bool has() const { return slots_.has(); }
+        inline uint32_t seq() const { return slots_.seq(); }
+        inline WaitStamp stamp() const { return slots_.stamp(); }
+
+    private:
+        SeqBuffer<value_type> slots_;
+    };
+} // namespace regbus
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // Wrap-safe "a is newer than b" for 32-bit register sequences
+    inline constexpr bool seq_newer(uint32_t a, uint32_t b)
+    {
+        return static_cast<int32_t>(a - b) > 0;
+    }
+
+    // Should seq s go to a peer whose cursor holds c? Cursor 0 means "never
+    // seen": everything written is sent, even seqs 2^31 or more ahead of 0.
+    inline constexpr bool seq_ahead_of_cursor(uint32_t s, uint32_t c)
+    {
+        return c == 0 ? s != 0 : seq_newer(s, c);
+    }
+
+    // SyncCursor: last-seen sequence per key of a Registry (0 = never seen).
+    //
+    // The receiving side of a bridge owns one and keeps it across reconnects.
+    // On reconnect it sends the cursor to the sender (encode/decode give a
+    // compact little-endian form), which then transmits only newer values.
+    // If the *sender* restarted, its sequences start over: the receiver must
+    // reset() its cursor and take a full sync.
+    template <typename Reg>
+    class SyncCursor
+    {
+    public:
+        static constexpr std::size_t size = Reg::size();
+        // Wire size: u32 key count followed by one u32 sequence per key
+        static constexpr std::size_t encoded_bytes = 4 + 4 * size;
+
+        uint32_t get(std::size_t i) const { return seq_[i]; }
+        void set(std::size_t i, uint32_t s) { seq_[i] = s; }
+        void reset() { seq_.fill(0); }
+
+        // Sender side, Options<Key>::config: this peer's view of the config
+        typename Reg::config_reader_t &config_reader() { return config_; }
+
+        template <typename Reg::key_type K>
+        uint32_t get() const { return seq_[Reg::template index<K>()]; }
+
+        // Receiver side: write a value received from the sender and remember
+        // the sender's sequence. Stale or duplicate values are dropped.
+        template <typename Reg::key_type K>
+        bool apply(Reg &reg, const typename Reg::template value_t<K> &v, uint32_t seq)
+        {
+            constexpr std::size_t i = Reg::template index<K>();
+            if (!seq_ahead_of_cursor(seq, seq_[i]))
+                return false;
+            reg.template write<K>(v);
+            seq_[i] = seq;
+            return true;
+        }
+
+        // Serialize into out[encoded_bytes]
+        void encode(uint8_t *out) const
+        {
+            put_u32(out, static_cast<uint32_t>(size));
+            for (std::size_t i = 0; i < size; ++i)
+                put_u32(out + 4 + 4 * i, seq_[i]);
+        }
+
+        // Parse a peer's cursor; a key-count mismatch (different key lists on
+        // each side) resets to a full sync and returns false.
+        bool decode(const uint8_t *in, std::size_t n)
+        {
+            if (n < encoded_bytes || get_u32(in) != size)
+            {
+                reset();
+                return false;
+            }
+            for (std::size_t i = 0; i < size; ++i)
+                seq_[i] = get_u32(in + 4 + 4 * i);
+            return true;
+        }
+
+    private:
+        static void put_u32(uint8_t *p, uint32_t v)
+        {
+            p[0] = uint8_t(v);
+            p[1] = uint8_t(v >> 8);
+            p[2] = uint8_t(v >> 16);
+            p[3] = uint8_t(v >> 24);
+        }
+        static uint32_t get_u32(const uint8_t *p)
+        {
+            return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+        }
+
+        std::array<uint32_t, size> seq_{};
+        typename Reg::config_reader_t config_{};
+    };
+
+    // Sender side: for every Data key whose current seq is newer than
+    // cursor, calls sink(key_c<K>{}, const value_t<K>&, seq) with a coherent
+    // snapshot and advances cursor. Returns the number of keys sent.
+    //
+    // Keep one cursor per peer, seeded from the peer's decoded cursor on
+    // (re)connect; subsequent calls then stream deltas only. With
+    // Options<Key>::config, keys not bridged() are skipped and keep their
+    // cursor, so re-enabling one sends its latest value.
+    template <typename Reg, typename Sink>
+    std::size_t sync_newer(const Reg &reg, SyncCursor<Reg> &cursor, Sink &&sink)
+    {
+        const typename Reg::config_reader_t::Scope scope(cursor.config_reader(), reg); // no config: no-op
+        const typename Reg::config_t *cfg = scope.get();
+        std::size_t sent = 0;
+        Reg::for_each_key([&](auto key)
+                          {
+            constexpr auto K = decltype(key)::value;
+            if constexpr (Reg::template kind<K> == Kind::Data)
+            {
+                constexpr std::size_t i = Reg::template index<K>();
+                if (cfg && !cfg->bridged(i))
+                    return;
+                typename Reg::template value_t<K> v{};
+                uint32_t s = 0;
+                if (reg.template read<K>(v, &s) && seq_ahead_of_cursor(s, cursor.get(i)))
+                {
+                    sink(key, std::as_const(v), s);
+                    cursor.set(i, s);
+                    ++sent;
+                }
+            } });
+        return sent;
+    }
+} // namespace regbus
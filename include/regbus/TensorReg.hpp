@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Copy.hpp"
+#include "Futex.hpp"
+#include "SeqBuffer.hpp"
+
+namespace regbus
+{
+    // Tensor<T, Dims...>: fixed-shape numeric array, row-major, 64-byte
+    // aligned (a full cache line; also satisfies AVX/AVX-512 aligned loads).
+    template <typename T, std::size_t... Dims>
+    struct alignas(64) Tensor
+    {
+        static_assert(std::is_arithmetic<T>::value, "Tensor<T>: T must be arithmetic");
+        static_assert(sizeof...(Dims) > 0, "Tensor: at least one dimension");
+
+        using value_type = T;
+        static constexpr std::size_t rank = sizeof...(Dims);
+        static constexpr std::size_t size = (Dims * ...);
+        static constexpr std::size_t extent[rank] = {Dims...};
+
+        T data[size];
+
+        template <typename... I>
+        inline T &operator()(I... i)
+        {
+            static_assert(sizeof...(I) == rank, "Tensor: wrong number of indices");
+            return data[offset(std::size_t(i)...)];
+        }
+        template <typename... I>
+        inline const T &operator()(I... i) const
+        {
+            static_assert(sizeof...(I) == rank, "Tensor: wrong number of indices");
+            return data[offset(std::size_t(i)...)];
+        }
+
+        inline T *begin() { return data; }
+        inline T *end() { return data + size; }
+        inline const T *begin() const { return data; }
+        inline const T *end() const { return data + size; }
+
+    private:
+        template <typename... I>
+        static constexpr std::size_t offset(I... i)
+        {
+            std::size_t o = 0;
+            ((o = o * Dims + i), ...);
+            return o;
+        }
+    };
+
+    template <typename T>
+    struct is_tensor : std::false_type
+    {
+    };
+    template <typename T, std::size_t... Dims>
+    struct is_tensor<Tensor<T, Dims...>> : std::true_type
+    {
+    };
+
+    // TensorReg<Tn>: DBReg for Tensor values. Same double-buffer/seq protocol
+    // (SeqBuffer), with 64-byte aligned slots, streaming (non-temporal) publish copies for
+    // payloads >= REGBUS_NT_THRESHOLD, and in-place access on both sides:
+    // write_in_place(f) lets the producer compute straight into the back slot,
+    // visit(f) lets consumers compute on the live slot without copying it out.
+    template <typename Tn>
+    class TensorReg
+    {
+        static_assert(is_tensor<Tn>::value, "TensorReg<Tn>: Tn must be a regbus::Tensor");
+
+    public:
+        using value_type = Tn;
+
+        inline void write(const Tn &v)
+        {
+            copy_payload(&slots_.back(), &v, sizeof(Tn));
+            slots_.publish();
+        }
+
+        // f(Tn &) fills the back slot (its previous contents are unspecified);
+        // single writer only
+        template <typename F>
+        inline void write_in_place(F &&f)
+        {
+            f(slots_.back());
+            slots_.publish();
+        }
+
+        inline bool read(Tn &out, uint32_t *out_seq = nullptr) const
+        {
+            return visit([&](const Tn &s)
+                         { std::memcpy(&out, &s, sizeof(Tn)); }, out_seq);
+        }
+
+        // Calls f(const Tn &) on the live slot. f may run again if a write
+        // overlapped, and the reference is only valid inside f.
+        template <typename F>
+        inline bool visit(F &&f, uint32_t *out_seq = nullptr) const { return slots_.visit(f, out_seq); }
+
+        inline bool has() const { return slots_.has(); }
+        inline uint32_t seq() const { return slots_.seq(); }
+        inline WaitStamp stamp() const { return slots_.stamp(); }
+
+    private:
+        SeqBuffer<Tn> slots_; // each slot alignas(64) via Tn
+    };
+} // namespace regbus
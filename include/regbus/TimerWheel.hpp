@@ -0,0 +1,330 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "Registry.hpp"
+
+namespace regbus
+{
+    // TimerWheel: deferred and periodic Cmd posts / Data writes from a fixed
+    // pool of Capacity timers (no heap). Hierarchical wheel of 4 levels x 64
+    // slots: level l covers 64^(l+1) ticks, so at 1 ms per tick timers up to
+    // ~4.6 h land directly; longer ones park in the top level and re-cascade.
+    // Insert and cancel are O(1) (intrusive doubly-linked slot lists).
+    //
+    // Drive it either by calling tick(reg, now_us) from an existing loop, or
+    // with start(reg)/stop(), which runs one service thread. Scheduling and
+    // cancelling are safe from any thread (short spinlock; no allocation).
+    //
+    //   auto h = wheel.post_at<Key::CMD_RESET>(t_us, true);
+    //   wheel.post_every<Key::HEARTBEAT>(t_us, 100000, 1u);
+    //   wheel.write_at<Key::SETPOINT>(t_us, 42.f);
+    //   wheel.cancel(h);
+    template <typename Reg, std::size_t Capacity = 256, std::size_t PayloadBytes = 32>
+    class TimerWheel
+    {
+        using Key = typename Reg::key_type;
+        static constexpr unsigned bits = 6;
+        static constexpr uint32_t slots = 1u << bits, mask = slots - 1;
+        static constexpr unsigned levels = 4;
+        static constexpr uint32_t nil = 0xFFFFFFFFu;
+        static_assert(Capacity > 0 && Capacity < nil, "TimerWheel: bad capacity");
+
+    public:
+        // Generation-checked handle: a stale handle never cancels a reused timer
+        struct Handle
+        {
+            uint32_t idx = nil;
+            uint32_t gen = 0;
+            explicit operator bool() const { return idx != nil; }
+        };
+
+        // start_us is the clock tick() / start() will use (steady_now_us() for
+        // start()); there is no default, so the wheel never replays the whole
+        // uptime tick by tick on its first advance
+        TimerWheel(uint64_t tick_us, uint64_t start_us)
+            : tick_us_(tick_us ? tick_us : 1), now_tick_(start_us / tick_us_)
+        {
+            for (uint32_t i = 0; i < Capacity; ++i)
+                pool_[i].next = i + 1 < Capacity ? i + 1 : nil;
+            for (auto &lv : head_)
+                for (auto &h : lv)
+                    h = nil;
+        }
+
+        ~TimerWheel() { stop(); }
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        // ---- scheduling (returns an empty Handle when the pool is full) ----
+        template <Key K>
+        Handle post_at(uint64_t t_us, const typename Reg::template value_t<K> &v)
+        {
+            static_assert(Reg::template kind<K> == Kind::Cmd, "post_at<K>: K must be a Cmd key");
+            static_assert(fits<K>, "TimerWheel: value too large for PayloadBytes");
+            return add(t_us, 0, &fire_post<K>, &v, sizeof v);
+        }
+        template <Key K>
+        Handle post_every(uint64_t first_us, uint64_t period_us, const typename Reg::template value_t<K> &v)
+        {
+            static_assert(Reg::template kind<K> == Kind::Cmd, "post_every<K>: K must be a Cmd key");
+            static_assert(fits<K>, "TimerWheel: value too large for PayloadBytes");
+            return add(first_us, period_us, &fire_post<K>, &v, sizeof v);
+        }
+        template <Key K>
+        Handle write_at(uint64_t t_us, const typename Reg::template value_t<K> &v)
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "write_at<K>: K must be a Data key");
+            static_assert(fits<K>, "TimerWheel: value too large for PayloadBytes");
+            return add(t_us, 0, &fire_write<K>, &v, sizeof v);
+        }
+        template <Key K>
+        Handle write_every(uint64_t first_us, uint64_t period_us, const typename Reg::template value_t<K> &v)
+        {
+            static_assert(Reg::template kind<K> == Kind::Data, "write_every<K>: K must be a Data key");
+            static_assert(fits<K>, "TimerWheel: value too large for PayloadBytes");
+            return add(first_us, period_us, &fire_write<K>, &v, sizeof v);
+        }
+
+        // True if the timer was still scheduled
+        bool cancel(Handle h)
+        {
+            if (h.idx >= Capacity)
+                return false;
+            Guard g(lock_);
+            Timer &t = pool_[h.idx];
+            if (!t.active || t.gen != h.gen)
+                return false;
+            unlink(h.idx);
+            release(h.idx);
+            return true;
+        }
+
+        // Fires everything due up to now_us (in due order per tick); returns count fired
+        std::size_t tick(Reg &reg, uint64_t now_us)
+        {
+            const uint64_t target = now_us / tick_us_;
+            std::size_t fired = 0;
+            Guard g(lock_);
+            while (now_tick_ < target)
+            {
+                if (active_ == 0)
+                {
+                    now_tick_ = target; // idle: jump
+                    break;
+                }
+                ++now_tick_;
+                cascade();
+                fired += fire_slot(reg, uint32_t(now_tick_ & mask));
+            }
+            return fired;
+        }
+
+        std::size_t active() const { return active_; }
+        static constexpr std::size_t capacity() { return Capacity; }
+        uint64_t tick_us() const { return tick_us_; }
+
+        // ---- optional service thread ----
+        static uint64_t steady_now_us()
+        {
+            return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+        }
+
+        // Ticks against steady_now_us() once per tick_us until stop()
+        void start(Reg &reg)
+        {
+            if (thread_.joinable())
+                return;
+            run_.store(true, std::memory_order_release);
+            thread_ = std::thread([this, &reg]
+                                  {
+                while (run_.load(std::memory_order_acquire))
+                {
+                    tick(reg, steady_now_us());
+                    std::this_thread::sleep_for(std::chrono::microseconds(tick_us_));
+                } });
+        }
+        void stop()
+        {
+            run_.store(false, std::memory_order_release);
+            if (thread_.joinable())
+                thread_.join();
+        }
+
+    private:
+        using Fire = void (*)(Reg &, const unsigned char *);
+
+        struct Timer
+        {
+            uint64_t due;    // tick
+            uint64_t period; // ticks, 0 = one-shot
+            Fire fire;
+            uint32_t next, prev;
+            uint32_t gen;
+            uint8_t level;
+            uint8_t slot;
+            bool active;
+            alignas(8) unsigned char payload[PayloadBytes];
+        };
+
+        struct Guard
+        {
+            explicit Guard(std::atomic_flag &f) : f_(f)
+            {
+                while (f_.test_and_set(std::memory_order_acquire))
+                    std::this_thread::yield();
+            }
+            ~Guard() { f_.clear(std::memory_order_release); }
+            std::atomic_flag &f_;
+        };
+
+        template <Key K>
+        static constexpr bool fits = sizeof(typename Reg::template value_t<K>) <= PayloadBytes;
+
+        template <Key K>
+        static void fire_post(Reg &reg, const unsigned char *p)
+        {
+            typename Reg::template value_t<K> v;
+            std::memcpy(&v, p, sizeof v);
+            reg.template post<K>(v);
+        }
+        template <Key K>
+        static void fire_write(Reg &reg, const unsigned char *p)
+        {
+            typename Reg::template value_t<K> v;
+            std::memcpy(&v, p, sizeof v);
+            reg.template write<K>(v);
+        }
+
+        Handle add(uint64_t t_us, uint64_t period_us, Fire fire, const void *v, std::size_t n)
+        {
+            Guard g(lock_);
+            if (free_ == nil)
+                return Handle{};
+            const uint32_t i = free_;
+            Timer &t = pool_[i];
+            free_ = t.next;
+            t.due = t_us / tick_us_;
+            if (t.due <= now_tick_) // past due: next tick
+                t.due = now_tick_ + 1;
+            t.period = period_us ? (period_us + tick_us_ - 1) / tick_us_ : 0;
+            t.fire = fire;
+            t.active = true;
+            std::memcpy(t.payload, v, n);
+            ++active_;
+            insert(i);
+            return Handle{i, t.gen};
+        }
+
+        void release(uint32_t i)
+        {
+            Timer &t = pool_[i];
+            t.active = false;
+            ++t.gen;
+            t.next = free_;
+            free_ = i;
+            --active_;
+        }
+
+        // Place timer i by distance to its due tick; due == now_tick_ lands in
+        // the level-0 slot about to fire (cascade runs before fire_slot)
+        void insert(uint32_t i)
+        {
+            Timer &t = pool_[i];
+            const uint64_t delta = t.due - now_tick_;
+            unsigned l = 0;
+            while (l + 1 < levels && delta >= (uint64_t(1) << (bits * (l + 1))))
+                ++l;
+            uint64_t at = t.due;
+            if (delta >= (uint64_t(1) << (bits * levels))) // beyond range: park, re-cascade later
+                at = now_tick_ + (uint64_t(1) << (bits * levels)) - 1;
+            t.level = uint8_t(l);
+            t.slot = uint8_t((at >> (bits * l)) & mask);
+            uint32_t &h = head_[l][t.slot];
+            t.prev = nil;
+            t.next = h;
+            if (h != nil)
+                pool_[h].prev = i;
+            h = i;
+        }
+
+        void unlink(uint32_t i)
+        {
+            Timer &t = pool_[i];
+            if (t.prev != nil)
+                pool_[t.prev].next = t.next;
+            else
+                head_[t.level][t.slot] = t.next;
+            if (t.next != nil)
+                pool_[t.next].prev = t.prev;
+        }
+
+        // When a lower level wraps, move the next upper slot down
+        void cascade()
+        {
+            for (unsigned l = 1; l < levels; ++l)
+            {
+                if ((now_tick_ & ((uint64_t(1) << (bits * l)) - 1)) != 0)
+                    break;
+                uint32_t &h = head_[l][(now_tick_ >> (bits * l)) & mask];
+                uint32_t i = h;
+                h = nil;
+                while (i != nil)
+                {
+                    const uint32_t nx = pool_[i].next;
+                    insert(i);
+                    i = nx;
+                }
+            }
+        }
+
+        std::size_t fire_slot(Reg &reg, uint32_t slot)
+        {
+            std::size_t n = 0;
+            uint32_t i = head_[0][slot];
+            head_[0][slot] = nil;
+            while (i != nil)
+            {
+                Timer &t = pool_[i];
+                const uint32_t nx = t.next;
+                if (t.due > now_tick_) // a later lap of this slot
+                {
+                    insert(i);
+                }
+                else
+                {
+                    t.fire(reg, t.payload);
+                    ++n;
+                    if (t.period)
+                    {
+                        t.due += t.period;
+                        insert(i);
+                    }
+                    else
+                    {
+                        release(i);
+                    }
+                }
+                i = nx;
+            }
+            return n;
+        }
+
+        uint64_t tick_us_;
+        uint64_t now_tick_;
+        std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+        uint32_t free_ = 0;
+        std::size_t active_ = 0;
+        uint32_t head_[levels][slots];
+        Timer pool_[Capacity]{};
+        std::atomic<bool> run_{false};
+        std::thread thread_;
+    };
+} // namespace regbus
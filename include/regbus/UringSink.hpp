@@ -0,0 +1,387 @@
+#pragma once
+
+// Asynchronous file sink for recordings (Linux io_uring, pwrite fallback).
+//
+// Bytes handed to the sink are packed into BufBytes-sized, 4 KiB-aligned
+// buffers; each full buffer is submitted as one write at its file offset and
+// up to Depth buffers stay in flight, so the recording thread only waits when
+// the disk falls Depth buffers behind. With Depth = 1 every write completes
+// before its buffer is refilled. No fsync on the data path.
+//
+// Uses raw io_uring syscalls (no liburing dependency). When io_uring is not
+// available (old kernel, seccomp, non-Linux) or use_uring=false, the sink
+// falls back to synchronous pwrite() of the same aligned buffers.
+// With direct=true the file is opened O_DIRECT; the tail is padded to the
+// alignment on close() and the file truncated back to its true size.
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define REGBUS_HAS_IO_URING 1
+#endif
+#endif
+#ifndef REGBUS_HAS_IO_URING
+#define REGBUS_HAS_IO_URING 0
+#endif
+
+namespace regbus
+{
+    template <std::size_t BufBytes = (1u << 20), std::size_t Depth = 4>
+    class UringSink
+    {
+        static constexpr std::size_t align = 4096;
+        static_assert(BufBytes % align == 0, "UringSink: BufBytes must be a multiple of 4096");
+        static_assert(Depth >= 1 && Depth <= 64, "UringSink: Depth must be 1..64");
+
+    public:
+        UringSink() = default;
+        ~UringSink() { close(); }
+
+        UringSink(const UringSink &) = delete;
+        UringSink &operator=(const UringSink &) = delete;
+
+        bool open(const char *path, bool direct = false, bool use_uring = true)
+        {
+            close();
+            int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+            if (direct)
+                flags |= O_DIRECT;
+#else
+            if (direct)
+                return false;
+#endif
+            fd_ = ::open(path, flags, 0644);
+            if (fd_ < 0)
+                return false;
+            direct_ = direct;
+            for (auto &b : bufs_)
+            {
+                void *p = nullptr;
+                if (::posix_memalign(&p, align, BufBytes) != 0)
+                {
+                    close();
+                    return false;
+                }
+                b = static_cast<uint8_t *>(p);
+            }
+            cur_ = 0;
+            len_ = 0;
+            off_ = 0;
+            busy_ = 0;
+            written_ = 0;
+            error_ = 0;
+            uring_ = use_uring && ring_setup();
+            return true;
+        }
+
+        bool is_open() const { return fd_ >= 0; }
+        bool uring_active() const { return uring_; }
+        int error() const { return error_; }                  // first errno seen (0 = none)
+        uint64_t bytes() const { return off_ + len_; }        // accepted so far
+        uint64_t bytes_written() const { return written_; }   // completed on disk
+
+        // Sink interface: sink(const uint8_t *data, std::size_t n)
+        void operator()(const uint8_t *p, std::size_t n) { write(p, n); }
+
+        bool write(const void *data, std::size_t n)
+        {
+            if (fd_ < 0)
+                return false;
+            const uint8_t *p = static_cast<const uint8_t *>(data);
+            while (n)
+            {
+                std::size_t c = BufBytes - len_;
+                if (c > n)
+                    c = n;
+                std::memcpy(bufs_[cur_] + len_, p, c);
+                len_ += c;
+                p += c;
+                n -= c;
+                if (len_ == BufBytes && !submit_current(BufBytes))
+                    return false;
+            }
+            return error_ == 0;
+        }
+
+        // Push out everything buffered and wait for it to complete. In direct
+        // mode only the aligned prefix is written; the tail stays buffered.
+        bool flush()
+        {
+            if (fd_ < 0)
+                return false;
+            const std::size_t n = direct_ ? len_ / align * align : len_;
+            if (n && !submit_current(n))
+                return false;
+            wait_all();
+            return error_ == 0;
+        }
+
+        bool close()
+        {
+            if (fd_ < 0)
+                return error_ == 0;
+            flush();
+            if (len_) // direct mode tail: pad to alignment, then trim
+            {
+                const uint64_t size = off_ + len_;
+                std::memset(bufs_[cur_] + len_, 0, BufBytes - len_);
+                const std::size_t padded = (len_ + align - 1) / align * align;
+                len_ = padded;
+                submit_current(padded);
+                wait_all();
+                if (::ftruncate(fd_, off_t(size)) != 0)
+                    fail(errno);
+                off_ = size;
+            }
+            ring_teardown();
+            ::close(fd_);
+            fd_ = -1;
+            for (auto &b : bufs_)
+            {
+                std::free(b);
+                b = nullptr;
+            }
+            return error_ == 0;
+        }
+
+    private:
+        void fail(int e)
+        {
+            if (!error_)
+                error_ = e;
+        }
+
+        // Submit bufs_[cur_][0..n) at off_, carry any remainder to the next buffer
+        bool submit_current(std::size_t n)
+        {
+            const std::size_t next = (cur_ + 1) % Depth;
+            if (busy_ & (1ull << next))
+                wait_for(next);
+            const std::size_t rest = len_ - n;
+
+            if (uring_)
+                submit_uring(cur_, n, off_);
+            else
+                write_sync(bufs_[cur_], n, off_);
+            if (next == cur_) // Depth 1: the only buffer must land before it is reused
+                wait_for(cur_);
+            if (rest)
+                std::memmove(bufs_[next], bufs_[cur_] + n, rest);
+            off_ += n;
+            cur_ = next;
+            len_ = rest;
+            return error_ == 0;
+        }
+
+        void write_sync(const uint8_t *p, std::size_t n, uint64_t off)
+        {
+            while (n)
+            {
+                ssize_t w = ::pwrite(fd_, p, n, off_t(off));
+                if (w < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    fail(errno);
+                    return;
+                }
+                p += w;
+                n -= std::size_t(w);
+                off += uint64_t(w);
+                written_ += uint64_t(w);
+            }
+        }
+
+        void wait_all()
+        {
+            while (busy_)
+                reap(true);
+        }
+
+        void wait_for(std::size_t i)
+        {
+            while (busy_ & (1ull << i))
+                reap(true);
+        }
+
+#if REGBUS_HAS_IO_URING
+        struct Pending
+        {
+            uint64_t off;
+            uint32_t len;
+        };
+
+        bool ring_setup()
+        {
+            io_uring_params p{};
+            ring_fd_ = int(::syscall(__NR_io_uring_setup, unsigned(Depth), &p));
+            if (ring_fd_ < 0)
+                return false;
+            sq_sz_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cq_sz_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+            single_mmap_ = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap_)
+                sq_sz_ = cq_sz_ = (sq_sz_ > cq_sz_ ? sq_sz_ : cq_sz_);
+
+            sq_ptr_ = ::mmap(nullptr, sq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                             IORING_OFF_SQ_RING);
+            cq_ptr_ = single_mmap_ ? sq_ptr_
+                                   : ::mmap(nullptr, cq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                            ring_fd_, IORING_OFF_CQ_RING);
+            sqes_sz_ = p.sq_entries * sizeof(io_uring_sqe);
+            sqes_ = static_cast<io_uring_sqe *>(::mmap(nullptr, sqes_sz_, PROT_READ | PROT_WRITE,
+                                                       MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+            if (sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes_ == MAP_FAILED)
+            {
+                ring_teardown();
+                return false;
+            }
+            auto *sq = static_cast<uint8_t *>(sq_ptr_);
+            auto *cq = static_cast<uint8_t *>(cq_ptr_);
+            sq_tail_ = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+            sq_mask_ = *reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+            sq_array_ = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+            cq_head_ = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+            cq_tail_ = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+            cq_mask_ = *reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+            return true;
+        }
+
+        void ring_teardown()
+        {
+            if (sqes_ && sqes_ != MAP_FAILED)
+                ::munmap(sqes_, sqes_sz_);
+            if (cq_ptr_ && cq_ptr_ != MAP_FAILED && !single_mmap_)
+                ::munmap(cq_ptr_, cq_sz_);
+            if (sq_ptr_ && sq_ptr_ != MAP_FAILED)
+                ::munmap(sq_ptr_, sq_sz_);
+            sqes_ = nullptr;
+            sq_ptr_ = cq_ptr_ = nullptr;
+            if (ring_fd_ >= 0)
+                ::close(ring_fd_);
+            ring_fd_ = -1;
+            uring_ = false;
+        }
+
+        void submit_uring(std::size_t i, std::size_t n, uint64_t off)
+        {
+            const unsigned tail = *sq_tail_; // only we write the SQ tail
+            const unsigned idx = tail & sq_mask_;
+            io_uring_sqe &e = sqes_[idx];
+            std::memset(&e, 0, sizeof(e));
+            e.opcode = IORING_OP_WRITE;
+            e.fd = fd_;
+            e.addr = reinterpret_cast<uint64_t>(bufs_[i]);
+            e.len = uint32_t(n);
+            e.off = off;
+            e.user_data = i;
+            sq_array_[idx] = idx;
+            __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+            pending_[i] = {off, uint32_t(n)};
+            busy_ |= 1ull << i;
+            while (::syscall(__NR_io_uring_enter, ring_fd_, 1u, 0u, 0u, nullptr, 0) < 0)
+            {
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                {
+                    fail(errno);
+                    busy_ &= ~(1ull << i);
+                    return;
+                }
+                reap(false);
+            }
+            reap(false); // opportunistically retire finished writes
+        }
+
+        void reap(bool block)
+        {
+            if (!uring_)
+                return;
+            unsigned head = *cq_head_;
+            if (block && head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+            {
+                if (::syscall(__NR_io_uring_enter, ring_fd_, 0u, 1u, unsigned(IORING_ENTER_GETEVENTS), nullptr, 0) < 0 &&
+                    errno != EINTR)
+                {
+                    fail(errno);
+                    busy_ = 0;
+                    return;
+                }
+            }
+            while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+            {
+                const io_uring_cqe &c = cqes_[head & cq_mask_];
+                const std::size_t i = std::size_t(c.user_data);
+                const int res = c.res;
+                ++head;
+                __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+                const Pending pd = pending_[i];
+                if (res < 0)
+                {
+                    // Kernel without IORING_OP_WRITE: finish synchronously from now on
+                    if (res == -EINVAL || res == -EOPNOTSUPP)
+                        write_sync(bufs_[i], pd.len, pd.off), fallback_ = true;
+                    else
+                        fail(-res);
+                }
+                else
+                {
+                    written_ += uint64_t(res);
+                    if (uint32_t(res) < pd.len) // short write: complete it synchronously
+                        write_sync(bufs_[i] + res, pd.len - uint32_t(res), pd.off + uint64_t(res));
+                }
+                busy_ &= ~(1ull << i);
+            }
+            if (fallback_ && !busy_)
+                ring_teardown();
+        }
+
+        int ring_fd_ = -1;
+        bool single_mmap_ = false;
+        bool fallback_ = false;
+        void *sq_ptr_ = nullptr;
+        void *cq_ptr_ = nullptr;
+        std::size_t sq_sz_ = 0, cq_sz_ = 0, sqes_sz_ = 0;
+        io_uring_sqe *sqes_ = nullptr;
+        io_uring_cqe *cqes_ = nullptr;
+        unsigned *sq_tail_ = nullptr;
+        unsigned *sq_array_ = nullptr;
+        unsigned *cq_head_ = nullptr;
+        unsigned *cq_tail_ = nullptr;
+        unsigned sq_mask_ = 0, cq_mask_ = 0;
+        std::array<Pending, Depth> pending_{};
+#else
+        bool ring_setup() { return false; }
+        void ring_teardown() { uring_ = false; }
+        void submit_uring(std::size_t, std::size_t, uint64_t) {}
+        void reap(bool) { busy_ = 0; }
+#endif
+
+        int fd_ = -1;
+        bool direct_ = false;
+        bool uring_ = false;
+        int error_ = 0;
+        std::array<uint8_t *, Depth> bufs_{};
+        std::size_t cur_ = 0;  // buffer being filled
+        std::size_t len_ = 0;  // bytes in bufs_[cur_]
+        uint64_t off_ = 0;     // file offset of bufs_[cur_][0]
+        uint64_t written_ = 0; // bytes completed
+        uint64_t busy_ = 0;    // bit i set while bufs_[i] is in flight
+    };
+} // namespace regbus
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "BitReg.hpp"
+#include "Futex.hpp"
+
+namespace regbus
+{
+    template <typename Key, template <Key> class Traits, Key... Keys>
+    class Registry;
+
+    // WaitSet<N>: the caller's side of a multi-key wait over a registry of
+    // N keys (by Registry::index<K>()). Holds which keys are watched, the
+    // last published stamp seen per key (the cursors) and, after a wait,
+    // which keys fired. Build one with Registry::wait_set<Ks...>() or
+    // Registry::watch(ws, index) and pass it to wait_any / wait_all.
+    template <std::size_t N>
+    class WaitSet
+    {
+    public:
+        static constexpr std::size_t words = (N + 63) / 64;
+
+        inline bool watches(std::size_t i) const { return (mask_[i / 64] >> (i % 64)) & 1u; }
+        inline void unwatch(std::size_t i) { mask_[i / 64] &= ~(uint64_t(1) << (i % 64)); }
+
+        // Result of the last wait (keys whose stamp moved past the cursor)
+        inline bool fired(std::size_t i) const { return (fired_[i / 64] >> (i % 64)) & 1u; }
+        inline uint64_t fired_word(std::size_t w) const { return fired_[w]; }
+
+        // Calls f(index) for each fired key, ascending
+        template <typename F>
+        inline void for_each_fired(F &&f) const
+        {
+            for (std::size_t w = 0; w < words; ++w)
+                for (uint64_t m = fired_[w]; m; m &= m - 1)
+                    f(w * 64 + std::size_t(detail::ctz64(m)));
+        }
+
+    private:
+        template <typename K, template <K> class T, K... Ks>
+        friend class Registry;
+
+        std::array<uint64_t, words> mask_{};
+        std::array<uint64_t, words> fired_{};
+        std::array<uint32_t, N> seen_{};
+    };
+} // namespace regbus
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    TEMP,
+    VBAT,
+    PRESS,
+    PLAIN,
+    ALARMS
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::TEMP>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr float alarm_hi = 80.f;
+    static constexpr float alarm_hyst = 5.f;
+    static constexpr K alarm_cmd = K::ALARMS;
+};
+template <>
+struct Traits<K::VBAT>
+{
+    using type = int; // mV
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr int alarm_lo = 11000;
+    static constexpr int alarm_hi = 14600;
+    static constexpr int alarm_hyst = 200;
+};
+template <>
+struct Traits<K::PRESS>
+{
+    using type = double;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring;
+    static constexpr double alarm_hi = 2.0;
+    static constexpr K alarm_cmd = K::ALARMS;
+};
+template <>
+struct Traits<K::PLAIN>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::ALARMS>
+{
+    using type = regbus::AlarmEvent;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::TEMP, K::VBAT, K::PRESS, K::PLAIN, K::ALARMS>;
+using regbus::AlarmLevel;
+
+TEST(Alarm, HysteresisAndEdges)
+{
+    R r;
+    regbus::AlarmEvent ev{};
+    r.write<K::TEMP>(70.f);
+    EXPECT_EQ(r.alarm<K::TEMP>(), AlarmLevel::None);
+    EXPECT_FALSE(r.consume<K::ALARMS>(ev));
+
+    r.write<K::TEMP>(80.5f);
+    EXPECT_EQ(r.alarm<K::TEMP>(), AlarmLevel::High);
+    ASSERT_TRUE(r.consume<K::ALARMS>(ev));
+    EXPECT_EQ(ev.key, R::index<K::TEMP>());
+    EXPECT_EQ(ev.level, AlarmLevel::High);
+
+    r.write<K::TEMP>(78.f); // inside hysteresis band: stays raised, no new edge
+    EXPECT_EQ(r.alarm<K::TEMP>(), AlarmLevel::High);
+    r.write<K::TEMP>(90.f);
+    EXPECT_FALSE(r.consume<K::ALARMS>(ev));
+
+    r.write<K::TEMP>(74.9f);
+    EXPECT_EQ(r.alarm<K::TEMP>(), AlarmLevel::None);
+    ASSERT_TRUE(r.consume<K::ALARMS>(ev));
+    EXPECT_EQ(ev.level, AlarmLevel::None);
+}
+
+TEST(Alarm, LowAndHighLimitsWithoutCmd)
+{
+    R r;
+    r.write<K::VBAT>(12000);
+    EXPECT_EQ(r.alarm<K::VBAT>(), AlarmLevel::None);
+    r.write<K::VBAT>(10900);
+    EXPECT_EQ(r.alarm<K::VBAT>(), AlarmLevel::Low);
+    r.write<K::VBAT>(11100); // < 11000 + 200
+    EXPECT_EQ(r.alarm<K::VBAT>(), AlarmLevel::Low);
+    r.write<K::VBAT>(15000); // straight across to the other side
+    EXPECT_EQ(r.alarm<K::VBAT>(), AlarmLevel::High);
+    r.write<K::VBAT>(14500);
+    EXPECT_EQ(r.alarm<K::VBAT>(), AlarmLevel::High);
+    r.write<K::VBAT>(14400);
+    EXPECT_EQ(r.alarm<K::VBAT>(), AlarmLevel::None);
+}
+
+TEST(Alarm, BitmapAndRingKeys)
+{
+    R r;
+    static_assert(R::alarm_words() == 1, "one word for five keys");
+    EXPECT_FALSE(r.any_alarm());
+
+    r.write<K::PRESS>(10, 2.5);
+    r.write<K::VBAT>(9000);
+    r.write<K::PLAIN>(1 << 30); // no limits: never alarms
+    EXPECT_TRUE(r.any_alarm());
+    EXPECT_EQ(r.alarm_count(), 2u);
+    EXPECT_EQ(r.alarm_word(0), (1ull << R::index<K::PRESS>()) | (1ull << R::index<K::VBAT>()));
+
+    regbus::AlarmEvent ev{};
+    ASSERT_TRUE(r.consume<K::ALARMS>(ev));
+    EXPECT_EQ(ev.key, R::index<K::PRESS>());
+
+    r.write<K::PRESS>(20, 1.0);
+    r.write<K::VBAT>(12000);
+    EXPECT_FALSE(r.any_alarm());
+}
+
+// Short excursions between polls are never missed: every raise is an edge.
+TEST(Alarm, EveryExcursionRaisesOneEdge)
+{
+    R r;
+    std::atomic<int> raised{0};
+    std::atomic<bool> done{false};
+    std::thread mon([&]
+                    {
+        regbus::AlarmEvent ev{};
+        while (!done.load() || r.pending<K::ALARMS>())
+        {
+            if (!r.consume<K::ALARMS>(ev))
+                std::this_thread::yield();
+            else if (ev.level == AlarmLevel::High)
+                ++raised;
+        } });
+
+    for (int i = 0; i < 200; ++i)
+    {
+        r.write<K::TEMP>(100.f); // 1-sample spike
+        while (r.pending<K::ALARMS>()) // single-slot Cmd: let the monitor drain
+            std::this_thread::yield();
+        r.write<K::TEMP>(20.f);
+        while (r.pending<K::ALARMS>())
+            std::this_thread::yield();
+    }
+    done = true;
+    mon.join();
+    EXPECT_EQ(raised.load(), 200);
+}
+
+TEST(Alarm, NoAlarmKeysNoStorage)
+{
+    static_assert(regbus::detail::has_alarm<Traits<K::TEMP>>::value, "");
+    static_assert(!regbus::detail::has_alarm<Traits<K::PLAIN>>::value, "");
+    using RP = regbus::Registry<K, Traits, K::PLAIN>;
+    static_assert(RP::alarm_words() == 0, "no bitmap without limits");
+    RP r;
+    EXPECT_FALSE(r.any_alarm());
+}
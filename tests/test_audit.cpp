@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    SPEED,
+    RESET,
+    MODE,
+    GOTO
+};
+
+struct Target
+{
+    float x, y, z;
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::SPEED>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::RESET>
+{
+    using type = uint32_t;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+template <>
+struct Traits<K::MODE>
+{
+    using type = uint8_t;
+    static constexpr regbus::Kind kind = regbus::Kind::PrioCmd;
+};
+template <>
+struct Traits<K::GOTO>
+{
+    using type = Target;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+template <>
+struct regbus::Options<K>
+{
+    static constexpr std::size_t audit_depth = 8;
+    static constexpr std::size_t audit_bytes = 8;
+};
+
+using R = regbus::Registry<K, Traits, K::SPEED, K::RESET, K::MODE, K::GOTO>;
+
+std::vector<R::audit_record_t> records(const R &r)
+{
+    std::vector<R::audit_record_t> v;
+    r.audit().dump([&](const R::audit_record_t &rec)
+                   { v.push_back(rec); });
+    return v;
+}
+
+TEST(Audit, RecordsPostsAndConsumes)
+{
+    static_assert(R::audit_enabled, "enabled through Options<K>");
+    R r;
+    r.write<K::SPEED>(1.f); // data writes are not audited
+    r.post<K::RESET>(41);
+    r.post<K::RESET>(42); // supersedes 41
+    uint32_t v = 0;
+    EXPECT_TRUE(r.consume<K::RESET>(v));
+    EXPECT_TRUE(r.post<K::MODE>(3, 10, 7));
+    EXPECT_FALSE(r.post<K::MODE>(1, 5, 8)); // rejected: not audited
+    r.post<K::GOTO>(Target{1.f, 2.f, 3.f});
+
+    const auto recs = records(r);
+    ASSERT_EQ(recs.size(), 4u);
+    EXPECT_EQ(recs[0].key, R::index<K::RESET>());
+    EXPECT_EQ(recs[0].consume_us, 0u);
+    EXPECT_TRUE(recs[0].superseded);
+    uint32_t x;
+    std::memcpy(&x, recs[1].value, sizeof x);
+    EXPECT_EQ(x, 42u);
+    EXPECT_GE(recs[1].consume_us, recs[1].post_us);
+    EXPECT_NE(recs[1].consume_us, 0u);
+    EXPECT_FALSE(recs[1].superseded);
+    EXPECT_EQ(recs[2].key, R::index<K::MODE>());
+    EXPECT_EQ(recs[2].value[0], 3);
+    EXPECT_FALSE(recs[2].superseded); // still pending
+    EXPECT_EQ(recs[3].size, sizeof(Target)); // value truncated to audit_bytes
+    float f[2];
+    std::memcpy(f, recs[3].value, sizeof f);
+    EXPECT_EQ(f[1], 2.f);
+    EXPECT_EQ(recs[0].thread, recs[3].thread);
+    for (std::size_t i = 1; i < recs.size(); ++i)
+        EXPECT_EQ(recs[i].seq, recs[i - 1].seq + 1);
+}
+
+TEST(Audit, RingKeepsNewest)
+{
+    R r;
+    for (uint32_t i = 1; i <= 20; ++i)
+        r.post<K::RESET>(i);
+    const auto recs = records(r);
+    EXPECT_EQ(r.audit().recorded(), 20u);
+    ASSERT_EQ(recs.size(), 8u);
+    EXPECT_EQ(recs.front().seq, 13u);
+    uint32_t x;
+    std::memcpy(&x, recs.back().value, sizeof x);
+    EXPECT_EQ(x, 20u);
+}
+
+// Concurrent posters from several threads: every settled record is whole
+TEST(Audit, ConcurrentPostersProduceCoherentRecords)
+{
+    static R r;
+    std::atomic<int> bad{0};
+    std::atomic<bool> stop{false};
+    std::thread dumper([&]
+                       {
+        while (!stop.load())
+        {
+            r.audit().dump([&](const R::audit_record_t &rec)
+                           {
+                uint32_t x;
+                std::memcpy(&x, rec.value, sizeof x);
+                if (rec.key != R::index<K::RESET>() || (x >> 16) != rec.thread)
+                    ++bad; });
+            std::this_thread::yield();
+        } });
+
+    std::vector<std::thread> posters;
+    for (int t = 0; t < 3; ++t)
+        posters.emplace_back([&]
+                             {
+            const uint32_t tag = regbus::detail::thread_tag();
+            for (uint32_t i = 0; i < 2000; ++i)
+                r.post<K::RESET>(tag << 16 | i); });
+    for (auto &p : posters)
+        p.join();
+    stop = true;
+    dumper.join();
+    EXPECT_EQ(bad.load(), 0);
+}
+
+// The record's seq travels with the command: a consume closes exactly the
+// post it took, even when another post lands in between, and preempted
+// posts are marked superseded.
+TEST(Audit, ConsumeClosesTheRecordItTook)
+{
+    for (int round = 0; round < 100; ++round)
+    {
+        auto r = std::make_unique<R>();
+        std::vector<uint8_t> got;
+        std::atomic<bool> done{false};
+        std::thread consumer([&]
+                             {
+            uint8_t v;
+            while (!done.load())
+                if (r->consume<K::MODE>(v))
+                    got.push_back(v);
+            while (r->consume<K::MODE>(v))
+                got.push_back(v); });
+        std::thread poster([&]
+                           {
+            for (uint8_t i = 1; i <= 6; ++i) // fits the 8-deep ring
+            {
+                ASSERT_TRUE(r->post<K::MODE>(i, 5));
+                std::this_thread::yield();
+            } });
+        poster.join();
+        done = true;
+        consumer.join();
+
+        std::size_t consumed = 0;
+        for (const auto &rec : records(*r))
+        {
+            const bool took = std::find(got.begin(), got.end(), rec.value[0]) != got.end();
+            ASSERT_EQ(took, rec.consume_us != 0) << "value " << int(rec.value[0]);
+            ASSERT_EQ(!took, rec.superseded) << "value " << int(rec.value[0]);
+            consumed += took;
+        }
+        ASSERT_EQ(consumed, got.size());
+    }
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    FAULTS,
+    MODE
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::FAULTS>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Bits;
+    static constexpr std::size_t bits = 3000;
+};
+template <>
+struct Traits<K::MODE>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+template <>
+struct regbus::Options<K>
+{
+    static constexpr bool generation = true;
+};
+
+using R = regbus::Registry<K, Traits, K::FAULTS, K::MODE>;
+
+TEST(BitReg, SetClearToggleTest)
+{
+    regbus::BitReg<130> b;
+    static_assert(regbus::BitReg<130>::words == 3, "");
+    EXPECT_FALSE(b.any());
+    EXPECT_FALSE(b.set(0));
+    EXPECT_TRUE(b.set(0)); // previous value
+    EXPECT_FALSE(b.set(129));
+    EXPECT_TRUE(b.test(0));
+    EXPECT_TRUE(b.test(129));
+    EXPECT_FALSE(b.test(64));
+    EXPECT_FALSE(b.toggle(64));
+    EXPECT_TRUE(b.test(64));
+    EXPECT_TRUE(b.toggle(64));
+    EXPECT_FALSE(b.test(64));
+    EXPECT_TRUE(b.clear(0));
+    EXPECT_FALSE(b.assign(5, true));
+    EXPECT_TRUE(b.assign(5, false));
+    EXPECT_EQ(b.count(), 1u);
+    EXPECT_TRUE(b.any());
+}
+
+TEST(BitReg, FindFirstAndSnapshot)
+{
+    regbus::BitReg<200> b;
+    EXPECT_EQ(b.find_first(), 200u);
+    b.set(3);
+    b.set(70);
+    b.set(199);
+    EXPECT_EQ(b.find_first(), 3u);
+    EXPECT_EQ(b.find_first(4), 70u);
+    EXPECT_EQ(b.find_first(71), 199u);
+    EXPECT_EQ(b.find_first(200), 200u);
+
+    uint64_t w[regbus::BitReg<200>::words];
+    b.snapshot(w);
+    EXPECT_EQ(w[0], 1ull << 3);
+    EXPECT_EQ(w[1], 1ull << 6);
+    EXPECT_EQ(w[3], 1ull << 7);
+    EXPECT_EQ(b.seq(), 3u);
+}
+
+TEST(BitReg, RegistryPacksFlags)
+{
+    R r;
+    EXPECT_FALSE(r.flags<K::FAULTS>().any());
+    EXPECT_FALSE(r.set<K::FAULTS>(2999));
+    EXPECT_TRUE(r.test<K::FAULTS>(2999));
+    EXPECT_FALSE(r.toggle<K::FAULTS>(1234));
+    EXPECT_TRUE(r.clear<K::FAULTS>(2999));
+    EXPECT_TRUE(r.flags<K::FAULTS>().any());
+    EXPECT_EQ(r.flags<K::FAULTS>().find_first(), 1234u);
+
+    // 3000 flags in 94 versioned slots, far below 3000 separate registers
+    static_assert(sizeof(regbus::BitReg<3000>) <= 94 * 8, "BitReg bloat");
+    static_assert(R::bytes() < 3000 * sizeof(regbus::DBReg<bool>) / 20, "packing ratio");
+}
+
+// Writers flip two flags in different words as a pair (set both, clear both);
+// a coherent snapshot never shows exactly one of them set between pairs.
+TEST(BitReg, SnapshotIsCoherentAcrossWords)
+{
+    static regbus::BitReg<256> b;
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0}, snaps{0};
+
+    std::thread w([&]
+                  {
+        for (int i = 0; i < 20000; ++i)
+        {
+            b.set(10);
+            b.set(200);
+            b.clear(200);
+            b.clear(10);
+        }
+        stop = true; });
+
+    std::thread rd([&]
+                   {
+        uint64_t s[regbus::BitReg<256>::words];
+        while (!stop.load())
+        {
+            b.snapshot(s);
+            const bool lo = (s[0] >> 10) & 1, hi = (s[3] >> 8) & 1;
+            if (hi && !lo) // 200 only set while 10 is set
+                ++torn;
+            ++snaps;
+        } });
+
+    w.join();
+    rd.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(b.count(), 0u);
+}
+
+// Every mutation that changes a flag bumps its slot's version; setting a set
+// flag or clearing a clear one publishes nothing. A stamp never shows a
+// mutation in flight.
+TEST(BitReg, VersionsCountMutationsPerSlot)
+{
+    regbus::BitReg<100> b;
+    EXPECT_FALSE(b.set(1));
+    EXPECT_TRUE(b.set(1)); // no-op
+    b.set(40);
+    EXPECT_FALSE(b.clear(99)); // no-op
+    EXPECT_EQ(b.seq(), 2u);
+    b.toggle(99);
+    b.toggle(99);
+    EXPECT_EQ(b.seq(), 4u);
+    const regbus::WaitStamp st = b.stamp();
+    EXPECT_EQ(st.started, st.published);
+    EXPECT_EQ(b.word(0), (1ull << 1) | (1ull << 40));
+    EXPECT_EQ(b.count(), 2u);
+}
+
+// Out-of-range indices are ignored; the templated forms check at compile time.
+TEST(BitReg, IndexOutOfRangeIsIgnored)
+{
+    regbus::BitReg<40> b;
+    EXPECT_FALSE(b.set(40));
+    EXPECT_FALSE(b.toggle(1000));
+    EXPECT_FALSE(b.test(40));
+    EXPECT_EQ(b.seq(), 0u);
+    EXPECT_EQ(b.count(), 0u);
+
+    EXPECT_FALSE(b.set<39>());
+    EXPECT_TRUE(b.test<39>());
+    EXPECT_TRUE(b.clear<39>());
+    EXPECT_FALSE(b.toggle<0>());
+    EXPECT_EQ(b.count(), 1u);
+}
+
+// A set or clear that changes nothing does not bump the registry generation.
+TEST(BitReg, RegistryNoOpWritesNotifyNobody)
+{
+    R reg;
+    const uint64_t g0 = reg.generation();
+    reg.set<K::FAULTS>(7);
+    EXPECT_EQ(reg.generation(), g0 + 1);
+    reg.set<K::FAULTS>(7);
+    reg.clear<K::FAULTS>(8);
+    reg.set<K::FAULTS>(3000); // out of range
+    EXPECT_EQ(reg.generation(), g0 + 1);
+    reg.clear<K::FAULTS>(7);
+    EXPECT_EQ(reg.generation(), g0 + 2);
+}
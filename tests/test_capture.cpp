@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "regbus/Capture.hpp"
+
+enum class K : uint8_t
+{
+    VOLT,
+    CURR,
+    CMD_FAULT
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::VOLT>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::CURR>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::CMD_FAULT>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::VOLT, K::CURR, K::CMD_FAULT>;
+// 1 ms sampling: 2 s pre ring is 2000 samples, 1 s post is 1000
+using Cap = regbus::TriggeredCapture<R, 2000, 1000, K::VOLT, K::CURR>;
+
+static std::vector<uint64_t> times(const Cap &c)
+{
+    std::vector<uint64_t> t;
+    c.for_each<K::CURR>([&](uint64_t ts, const int &) { t.push_back(ts); });
+    return t;
+}
+
+TEST(Capture, CmdTriggerFreezesPreAndFillsPostWindow)
+{
+    R r;
+    Cap cap(2000000, 1000000);
+    ASSERT_TRUE(cap.trigger_on_cmd<K::CMD_FAULT>());
+
+    uint64_t now = 0;
+    for (int i = 0; i < 5000; ++i, now += 1000) // 5 s of history
+    {
+        r.write<K::CURR>(i);
+        EXPECT_EQ(cap.poll(r, now), Cap::State::Armed);
+    }
+
+    r.post<K::CMD_FAULT>(true);
+    r.write<K::CURR>(5000);
+    EXPECT_EQ(cap.poll(r, now), Cap::State::Triggered);
+    const uint64_t t0 = now;
+    EXPECT_EQ(cap.trigger_time(), t0);
+
+    for (int i = 5001; i < 7000 && cap.state() != Cap::State::Done; ++i)
+    {
+        now += 1000;
+        r.write<K::CURR>(i);
+        cap.poll(r, now);
+    }
+    EXPECT_EQ(cap.state(), Cap::State::Done);
+
+    auto t = times(cap);
+    ASSERT_FALSE(t.empty());
+    EXPECT_GE(t.front(), t0 - 2000000);
+    EXPECT_LE(t.front(), t0 - 1990000);
+    EXPECT_GE(t.back(), t0 + 999000);
+    for (std::size_t i = 1; i < t.size(); ++i)
+        ASSERT_LT(t[i - 1], t[i]);
+
+    // Frozen: more writes do not change the capture
+    r.write<K::CURR>(-1);
+    cap.poll(r, now + 1000);
+    EXPECT_EQ(times(cap), t);
+}
+
+TEST(Capture, PredicateTriggerAndRearm)
+{
+    R r;
+    Cap cap(10000, 5000);
+    ASSERT_TRUE(cap.trigger_when<K::VOLT>([](const float &v)
+                                          { return v < 10.5f; }));
+
+    uint64_t now = 0;
+    for (int i = 0; i < 20; ++i, now += 1000)
+    {
+        r.write<K::VOLT>(12.0f);
+        cap.poll(r, now);
+    }
+    EXPECT_EQ(cap.state(), Cap::State::Armed);
+
+    r.write<K::VOLT>(10.0f);
+    EXPECT_EQ(cap.poll(r, now), Cap::State::Triggered);
+
+    std::size_t pre = 0;
+    cap.for_each<K::VOLT>([&](uint64_t ts, const float &)
+                          { pre += ts <= cap.trigger_time(); });
+    EXPECT_EQ(pre, 11u); // 10 ms pre window at 1 ms plus the trigger sample
+
+    for (int i = 0; i < 10; ++i)
+    {
+        now += 1000;
+        r.write<K::VOLT>(10.0f);
+        cap.poll(r, now);
+    }
+    EXPECT_EQ(cap.state(), Cap::State::Done);
+
+    cap.rearm();
+    EXPECT_EQ(cap.state(), Cap::State::Armed);
+    EXPECT_EQ(cap.for_each<K::VOLT>([](uint64_t, const float &) {}), 0u);
+}
+
+TEST(Capture, PostBufferFullEndsCapture)
+{
+    R r;
+    regbus::TriggeredCapture<R, 8, 4, K::CURR> cap(1000000, 1000000);
+    cap.fire(0);
+    for (int i = 0; i < 4; ++i)
+    {
+        r.write<K::CURR>(i);
+        cap.poll(r, uint64_t(i));
+    }
+    EXPECT_EQ(cap.poll(r, 5), decltype(cap)::State::Done);
+}
+
+// A command posted and consumed between two polls is never seen pending,
+// but still fires; posts made while the capture was not armed do not.
+TEST(Capture, CmdTriggerSeesConsumedPosts)
+{
+    R r;
+    Cap cap(10000, 2000);
+    ASSERT_TRUE(cap.trigger_on_cmd<K::CMD_FAULT>());
+    EXPECT_EQ(cap.poll(r, 0), Cap::State::Armed);
+
+    bool v = false;
+    r.post<K::CMD_FAULT>(true);
+    ASSERT_TRUE(r.consume<K::CMD_FAULT>(v));
+    EXPECT_EQ(cap.poll(r, 1000), Cap::State::Triggered);
+    EXPECT_EQ(cap.poll(r, 3000), Cap::State::Done);
+
+    r.post<K::CMD_FAULT>(true); // while done
+    cap.rearm();
+    EXPECT_EQ(cap.poll(r, 4000), Cap::State::Armed);
+    r.post<K::CMD_FAULT>(true);
+    EXPECT_EQ(cap.poll(r, 5000), Cap::State::Triggered);
+}
+
+// Posts made before the trigger was installed are history, not a fault.
+TEST(Capture, CmdTriggerIgnoresEarlierPosts)
+{
+    R r;
+    bool v = false;
+    r.post<K::CMD_FAULT>(true);
+    ASSERT_TRUE(r.consume<K::CMD_FAULT>(v));
+    r.post<K::CMD_FAULT>(true); // still pending
+
+    Cap cap(10000, 2000);
+    ASSERT_TRUE(cap.trigger_on_cmd<K::CMD_FAULT>());
+    EXPECT_EQ(cap.poll(r, 0), Cap::State::Armed);
+    EXPECT_EQ(cap.poll(r, 1000), Cap::State::Armed);
+    r.post<K::CMD_FAULT>(true);
+    EXPECT_EQ(cap.poll(r, 2000), Cap::State::Triggered);
+}
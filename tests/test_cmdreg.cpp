@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "regbus/CmdReg.hpp"
 
@@ -12,3 +15,36 @@ TEST(CmdReg, EdgeTriggered)
     EXPECT_EQ(v, 42);
     EXPECT_FALSE(c.consume(v)); // one-shot
 }
+
+TEST(CmdReg, ConsumeWaitTimesOut)
+{
+    regbus::CmdReg<int> c;
+    int v = 0;
+    const uint64_t t0 = regbus::detail::steady_us();
+    EXPECT_FALSE(c.consume_wait(v, 20000));
+    EXPECT_GE(regbus::detail::steady_us() - t0, 20000u);
+    c.post(1);
+    EXPECT_TRUE(c.consume_wait(v, 20000)); // already pending: no park
+    EXPECT_EQ(v, 1);
+}
+
+TEST(CmdReg, ConsumeWaitIsWokenByPost)
+{
+    regbus::CmdReg<uint64_t> c;
+    std::atomic<int> got{0};
+    std::thread consumer([&]
+                         {
+        uint64_t posted_at = 0;
+        for (int i = 0; i < 50; ++i)
+            if (c.consume_wait(posted_at, 2000000))
+                ++got; });
+    for (int i = 0; i < 50; ++i)
+    {
+        while (c.pending()) // one command in flight at a time
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        c.post(regbus::detail::steady_us());
+    }
+    consumer.join();
+    EXPECT_EQ(got.load(), 50);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "regbus/Columnar.hpp"
+
+enum class K : uint8_t
+{
+    IMU,
+    COUNT,
+    CMD_GO
+};
+
+struct Imu
+{
+    uint64_t t_us;
+    float ax;
+    int16_t temp;
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::IMU>
+{
+    using type = Imu;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr regbus::Field fields[] = {REGBUS_FIELD(Imu, t_us), REGBUS_FIELD(Imu, ax),
+                                               REGBUS_FIELD(Imu, temp)};
+};
+template <>
+struct Traits<K::COUNT>
+{
+    using type = uint32_t;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::CMD_GO>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::IMU, K::COUNT, K::CMD_GO>;
+
+struct VecSink
+{
+    std::vector<uint8_t> *out;
+    void operator()(const uint8_t *p, std::size_t n) { out->insert(out->end(), p, p + n); }
+};
+
+using X = regbus::ColumnarExporter<R, VecSink, 4>;
+
+// Minimal reader for the format documented in Columnar.hpp
+struct Reader
+{
+    const std::vector<uint8_t> &b;
+    std::size_t off = 0;
+    template <typename U>
+    U get()
+    {
+        U v;
+        std::memcpy(&v, &b[off], sizeof(U));
+        off += sizeof(U);
+        return v;
+    }
+};
+
+TEST(Columnar, FieldDescriptors)
+{
+    using F = regbus::fields_of<Traits<K::IMU>>;
+    static_assert(F::count() == 3, "");
+    static_assert(F::at(1).type == regbus::FieldType::F32, "");
+    static_assert(F::at(2).type == regbus::FieldType::I16, "");
+    static_assert(regbus::fields_of<Traits<K::COUNT>>::at(0).type == regbus::FieldType::U32, "");
+    EXPECT_STREQ(F::at(1).name, "ax");
+}
+
+TEST(Columnar, ChunksAreColumnMajor)
+{
+    std::vector<uint8_t> out;
+    {
+        X x(VecSink{&out});
+        for (int i = 0; i < 6; ++i) // one full chunk of 4 + a partial of 2
+            x.append<K::IMU>(1000 + i, Imu{uint64_t(i), float(i) * 0.5f, int16_t(-i)});
+        x.append<K::COUNT>(5, 42u);
+    }
+
+    Reader r{out};
+    ASSERT_EQ(0, std::memcmp(&out[0], "RBCOLv1", 8));
+    r.off = 8;
+    ASSERT_EQ(r.get<uint32_t>(), 2u); // Data keys only
+
+    // Schema: IMU
+    EXPECT_EQ(r.get<uint16_t>(), 0);
+    ASSERT_EQ(r.get<uint16_t>(), 3);
+    EXPECT_EQ(r.get<uint32_t>(), sizeof(Imu));
+    for (int f = 0; f < 3; ++f)
+    {
+        r.get<uint8_t>();
+        r.get<uint8_t>();
+        uint16_t len = r.get<uint16_t>();
+        r.get<uint32_t>();
+        r.get<uint32_t>();
+        r.off += len;
+    }
+    // Schema: COUNT ("value")
+    EXPECT_EQ(r.get<uint16_t>(), 1);
+    ASSERT_EQ(r.get<uint16_t>(), 1);
+    r.off += 4 + 1 + 1;
+    uint16_t len = r.get<uint16_t>();
+    r.off += 8 + len;
+
+    // First chunk: IMU rows 0..3
+    ASSERT_EQ(r.get<uint32_t>(), X::chunk_magic);
+    EXPECT_EQ(r.get<uint16_t>(), 0);
+    r.get<uint16_t>();
+    ASSERT_EQ(r.get<uint32_t>(), 4u);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(r.get<uint64_t>(), uint64_t(1000 + i));
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(r.get<uint64_t>(), uint64_t(i)); // t_us column
+    for (int i = 0; i < 4; ++i)
+        EXPECT_FLOAT_EQ(r.get<float>(), float(i) * 0.5f); // ax column
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(r.get<int16_t>(), -i); // temp column
+
+    // finish(): partial IMU chunk, then COUNT
+    ASSERT_EQ(r.get<uint32_t>(), X::chunk_magic);
+    EXPECT_EQ(r.get<uint16_t>(), 0);
+    r.get<uint16_t>();
+    ASSERT_EQ(r.get<uint32_t>(), 2u);
+    r.off += 2 * (8 + 8 + 4 + 2);
+
+    ASSERT_EQ(r.get<uint32_t>(), X::chunk_magic);
+    EXPECT_EQ(r.get<uint16_t>(), 1);
+    r.get<uint16_t>();
+    ASSERT_EQ(r.get<uint32_t>(), 1u);
+    EXPECT_EQ(r.get<uint64_t>(), 5u);
+    EXPECT_EQ(r.get<uint32_t>(), 42u);
+    EXPECT_EQ(r.off, out.size());
+}
+
+TEST(Columnar, CaptureRecordsOnlyChangedKeys)
+{
+    R reg;
+    std::vector<uint8_t> out;
+    X x(VecSink{&out});
+
+    reg.write<K::COUNT>(1u);
+    EXPECT_EQ(x.capture(reg, 10), 1u);
+    EXPECT_EQ(x.capture(reg, 20), 0u);
+    reg.write<K::IMU>({});
+    reg.write<K::COUNT>(2u);
+    EXPECT_EQ(x.capture(reg, 30), 2u);
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "regbus/Compressor.hpp"
+
+enum class K : uint8_t
+{
+    IMU,
+    ODOM,
+    CMD_GO
+};
+
+struct Imu
+{
+    float ax, ay, az;
+    uint16_t status;
+};
+struct Odom
+{
+    double x, y;
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::IMU>
+{
+    using type = Imu;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::ODOM>
+{
+    using type = Odom;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::CMD_GO>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::IMU, K::ODOM, K::CMD_GO>;
+
+struct Rec
+{
+    std::size_t key;
+    uint64_t t;
+    Imu imu;
+    Odom odom;
+};
+
+static Imu imu_at(int i) { return Imu{0.01f * float(i % 7), -0.5f, 9.81f, uint16_t(i < 500 ? 1 : 3)}; }
+static Odom odom_at(int i) { return Odom{double(i) * 0.25, 3.0}; }
+
+// Imu has tail padding: compare fields, not bytes
+static bool same(const Imu &a, const Imu &b)
+{
+    return a.ax == b.ax && a.ay == b.ay && a.az == b.az && a.status == b.status;
+}
+
+static std::vector<Rec> decode_all(const std::vector<uint8_t> &bytes)
+{
+    std::vector<Rec> out;
+    regbus::XorDecoder<R> dec;
+    dec.decode(bytes.data(), bytes.size(), [&](std::size_t k, uint64_t t, const uint8_t *b)
+               {
+        Rec r{k, t, {}, {}};
+        if (k == R::index<K::IMU>())
+            std::memcpy(&r.imu, b, sizeof(Imu));
+        else
+            std::memcpy(&r.odom, b, sizeof(Odom));
+        out.push_back(r); });
+    return out;
+}
+
+TEST(Compressor, BitIoRoundTrip)
+{
+    uint8_t buf[32] = {};
+    regbus::detail::BitWriter w;
+    w.reset(buf);
+    w.put(1, 1);
+    w.put(0x1234, 13);
+    w.put(0xDEADBEEFCAFEF00Dull, 64);
+    w.put(5, 3);
+    std::size_t n = w.finish();
+    EXPECT_EQ(n, (1 + 13 + 64 + 3 + 7) / 8);
+
+    regbus::detail::BitReader r(buf, n);
+    EXPECT_EQ(r.get(1), 1u);
+    EXPECT_EQ(r.get(13), 0x1234u & 0x1FFFu);
+    EXPECT_EQ(r.get(64), 0xDEADBEEFCAFEF00Dull);
+    EXPECT_EQ(r.get(3), 5u);
+}
+
+TEST(Compressor, EncodeDecodeIsLosslessAcrossBlocks)
+{
+    // Small blocks force several block boundaries
+    using E = regbus::XorEncoder<R, 256>;
+    E enc;
+    std::vector<uint8_t> block(256 + E::header_bytes), stream;
+    enc.begin(block.data());
+
+    auto emit = [&](std::size_t key, uint64_t t, const void *v)
+    {
+        if (!enc.fits())
+        {
+            std::size_t n = enc.end();
+            stream.insert(stream.end(), block.begin(), block.begin() + n);
+            enc.begin(block.data());
+        }
+        enc.encode(key, t, static_cast<const uint8_t *>(v));
+    };
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Imu a = imu_at(i);
+        emit(R::index<K::IMU>(), 1000000 + uint64_t(i) * 1000 + (i % 13 == 0 ? 7 : 0), &a);
+        if (i % 4 == 0)
+        {
+            Odom o = odom_at(i);
+            emit(R::index<K::ODOM>(), 5000000000ull + uint64_t(i) * 4000, &o);
+        }
+    }
+    std::size_t n = enc.end();
+    stream.insert(stream.end(), block.begin(), block.begin() + n);
+
+    auto recs = decode_all(stream);
+    ASSERT_EQ(recs.size(), 1000u + 250u);
+    std::size_t k = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const Rec &a = recs[k++];
+        ASSERT_EQ(a.key, R::index<K::IMU>());
+        EXPECT_EQ(a.t, 1000000 + uint64_t(i) * 1000 + (i % 13 == 0 ? 7 : 0));
+        Imu e = imu_at(i);
+        EXPECT_TRUE(same(a.imu, e)) << "at " << i;
+        if (i % 4 == 0)
+        {
+            const Rec &o = recs[k++];
+            ASSERT_EQ(o.key, R::index<K::ODOM>());
+            EXPECT_EQ(o.t, 5000000000ull + uint64_t(i) * 4000);
+            EXPECT_EQ(o.odom.x, odom_at(i).x);
+        }
+    }
+}
+
+TEST(Compressor, RecorderCompressesNearIdenticalSamples)
+{
+    std::vector<uint8_t> out;
+    std::mutex m;
+    auto sink = [&](const uint8_t *p, std::size_t n)
+    {
+        std::lock_guard<std::mutex> g(m);
+        out.insert(out.end(), p, p + n);
+    };
+
+    regbus::CompressingRecorder<R, decltype(sink), 1024, 4096> rec(sink);
+    rec.start();
+    const int N = 5000;
+    for (int i = 0; i < N; ++i)
+    {
+        while (!rec.record<K::IMU>(uint64_t(i) * 1000, imu_at(i)))
+            std::this_thread::yield(); // test wants every sample; real callers just count drops
+    }
+    rec.stop();
+
+    EXPECT_EQ(rec.samples(), uint64_t(N));
+    const std::size_t raw = std::size_t(N) * (sizeof(Imu) + 8);
+    EXPECT_LT(out.size() * 4, raw) << "expected > 4x compression, got " << out.size() << " bytes";
+
+    auto recs = decode_all(out);
+    ASSERT_EQ(recs.size(), std::size_t(N));
+    for (int i = 0; i < N; ++i)
+    {
+        Imu e = imu_at(i);
+        ASSERT_EQ(recs[i].t, uint64_t(i) * 1000);
+        ASSERT_TRUE(same(recs[i].imu, e)) << "at " << i;
+    }
+}
+
+TEST(Compressor, CaptureSkipsUnchangedKeysAndCountsDrops)
+{
+    R reg;
+    auto sink = [](const uint8_t *, std::size_t) {};
+    regbus::CompressingRecorder<R, decltype(sink), 8> rec(sink); // not started: ring fills
+    // 8 words: IMU and ODOM samples take 2 + 2 words each
+    reg.write<K::IMU>(imu_at(0));
+    EXPECT_EQ(rec.capture(reg, 1), 1u);
+    EXPECT_EQ(rec.capture(reg, 2), 0u);
+    reg.write<K::IMU>(imu_at(1));
+    reg.write<K::ODOM>(odom_at(1));
+    EXPECT_EQ(rec.capture(reg, 3), 1u); // ring holds one more
+    EXPECT_EQ(rec.dropped(), 1u);
+
+    rec.start(); // drains the ring
+    rec.stop();
+    EXPECT_EQ(rec.capture(reg, 4), 1u); // the dropped ODOM sample is retried
+    EXPECT_EQ(rec.capture(reg, 5), 0u);
+    EXPECT_EQ(rec.dropped(), 1u);
+}
+
+// A damaged block is skipped whole; the blocks around it still decode.
+TEST(Compressor, CorruptBlockIsSkipped)
+{
+    using E = regbus::XorEncoder<R, 128>;
+    E enc;
+    std::vector<uint8_t> block(128 + E::header_bytes), stream;
+    std::vector<std::size_t> starts, counts;
+    enc.begin(block.data());
+    std::size_t in_block = 0;
+    auto close = [&]
+    {
+        starts.push_back(stream.size());
+        counts.push_back(in_block);
+        std::size_t n = enc.end();
+        stream.insert(stream.end(), block.begin(), block.begin() + n);
+        enc.begin(block.data());
+        in_block = 0;
+    };
+    for (int i = 0; i < 400; ++i)
+    {
+        if (!enc.fits())
+            close();
+        Imu a = imu_at(i);
+        enc.encode(R::index<K::IMU>(), uint64_t(i) * 1000, reinterpret_cast<const uint8_t *>(&a));
+        ++in_block;
+    }
+    close();
+    ASSERT_GE(starts.size(), 3u);
+
+    // Block 1: payload of ones (out-of-range key); block 2: payload cut short
+    std::vector<uint8_t> bad = stream;
+    const std::size_t p1 = starts[1] + E::header_bytes, p2 = starts[2] + E::header_bytes;
+    std::fill(bad.begin() + long(p1), bad.begin() + long(starts[2]), uint8_t(0xFF));
+    uint32_t len2 = 0;
+    std::memcpy(&len2, &bad[p2 - 8], 4);
+    const uint32_t cut = len2 / 2;
+    std::memcpy(&bad[p2 - 8], &cut, 4);
+    bad.erase(bad.begin() + long(p2 + cut), bad.begin() + long(p2 + len2));
+
+    regbus::XorDecoder<R> dec;
+    std::size_t corrupt = 0;
+    std::vector<uint64_t> ts;
+    dec.decode(bad.data(), bad.size(), [&](std::size_t k, uint64_t t, const uint8_t *b)
+               {
+        Imu v;
+        std::memcpy(&v, b, sizeof(v));
+        EXPECT_EQ(k, R::index<K::IMU>());
+        EXPECT_TRUE(same(v, imu_at(int(t / 1000)))) << "at " << t;
+        ts.push_back(t); },
+               &corrupt);
+    EXPECT_EQ(corrupt, 2u);
+    EXPECT_EQ(ts.size(), 400u - counts[1] - counts[2]);
+    EXPECT_EQ(ts.front(), 0u);
+    EXPECT_EQ(ts.back(), 399000u);
+}
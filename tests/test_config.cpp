@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "regbus/Compressor.hpp"
+#include "regbus/Packer.hpp"
+#include "regbus/Sync.hpp"
+
+enum class K : uint8_t
+{
+    TEMP,
+    PRESSURE,
+    SPEED
+};
+
+template <K KK>
+struct Traits
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+template <>
+struct Traits<K::SPEED>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr uint32_t min_rate_hz = 20;
+};
+
+template <>
+struct regbus::Options<K>
+{
+    static constexpr bool config = true;
+    static constexpr std::size_t config_readers = 4;
+};
+
+using R = regbus::Registry<K, Traits, K::TEMP, K::PRESSURE, K::SPEED>;
+constexpr std::size_t TEMP = R::index<K::TEMP>(), PRESSURE = R::index<K::PRESSURE>(), SPEED = R::index<K::SPEED>();
+
+static std::vector<std::size_t> bridge(const R &reg, regbus::SyncCursor<R> &cur)
+{
+    std::vector<std::size_t> keys;
+    regbus::sync_newer(reg, cur, [&](auto key, const auto &, uint32_t)
+                       { keys.push_back(R::index<decltype(key)::value>()); });
+    return keys;
+}
+
+TEST(Config, BridgePolicySwapsLive)
+{
+    R reg;
+    regbus::SyncCursor<R> cur;
+    reg.write<K::TEMP>(1.f);
+    reg.write<K::PRESSURE>(2.f);
+    EXPECT_EQ(bridge(reg, cur), (std::vector<std::size_t>{TEMP, PRESSURE})); // default: everything
+
+    ASSERT_TRUE(reg.reconfigure([](R::config_t &c)
+                                { c.bridge(PRESSURE, false); }));
+    EXPECT_EQ(reg.config_block().version(), 1u);
+    reg.write<K::TEMP>(3.f);
+    reg.write<K::PRESSURE>(4.f);
+    EXPECT_EQ(bridge(reg, cur), (std::vector<std::size_t>{TEMP}));
+
+    ASSERT_TRUE(reg.reconfigure([](R::config_t &c)
+                                { c.bridge(PRESSURE, true); }));
+    EXPECT_EQ(bridge(reg, cur), (std::vector<std::size_t>{PRESSURE})); // latest value, once
+}
+
+TEST(Config, RecorderAndRateLimit)
+{
+    R reg;
+    auto sink = [](const uint8_t *, std::size_t) {};
+    regbus::CompressingRecorder<R, decltype(sink), 64> rec(sink); // not started
+    ASSERT_TRUE(reg.reconfigure([](R::config_t &c)
+                                {
+        c.record(SPEED, false);
+        c.max_rate_hz[TEMP] = 10; }));
+    reg.write<K::TEMP>(1.f);
+    reg.write<K::SPEED>(1.f);
+    EXPECT_EQ(rec.capture(reg, 1), 1u); // SPEED not recorded
+
+    regbus::Packer<R> pk(1000000);
+    std::size_t sent = 0;
+    auto out = [](const uint8_t *, std::size_t) {};
+    for (uint64_t t = 0; t < 1000000; t += 10000) // 1 s at 100 Hz, TEMP changes every cycle
+    {
+        reg.write<K::TEMP>(float(t));
+        sent += pk.cycle(reg, t, out);
+    }
+    EXPECT_EQ(pk.stats(TEMP).sent, 10u); // capped by the config, not Traits
+    EXPECT_GT(sent, 10u);
+}
+
+// A reader still inside the config from before the last swap keeps the
+// spare buffer busy: updates do not overwrite it until that reader leaves.
+TEST(Config, SpareBufferWaitsForOldReaders)
+{
+    R reg;
+    R::config_reader_t rd;
+    const R::config_t &seen = *rd.enter(reg.config_block());
+    EXPECT_EQ(seen.version, 0u);
+    ASSERT_TRUE(reg.try_reconfigure([](R::config_t &c)
+                                    { c.max_rate_hz[SPEED] = 5; })); // other buffer
+    EXPECT_FALSE(reg.try_reconfigure([](R::config_t &) {}));         // would overwrite `seen`
+    EXPECT_FALSE(reg.reconfigure([](R::config_t &) {}, 2000));
+    EXPECT_EQ(seen.max_rate_hz[SPEED], 0u);
+    rd.leave();
+    EXPECT_TRUE(reg.try_reconfigure([](R::config_t &c)
+                                    { c.max_rate_hz[SPEED] = 7; }));
+
+    const R::config_t &now = *rd.enter(reg.config_block());
+    EXPECT_EQ(now.version, 2u);
+    EXPECT_EQ(now.max_rate_hz[SPEED], 7u);
+    rd.leave();
+}
+
+// Readers never see a half-applied update while another thread reconfigures.
+TEST(Config, ReadersSeeWholeConfigs)
+{
+    R reg;
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+        readers.emplace_back([&]
+                             {
+            R::config_reader_t rd;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const R::config_t &c = *rd.enter(reg.config_block());
+                const uint32_t v = uint32_t(c.version);
+                for (std::size_t k = 0; k < R::size(); ++k)
+                    if (c.max_rate_hz[k] != v)
+                        torn.fetch_add(1);
+                rd.leave();
+            } });
+
+    for (uint32_t n = 1; n <= 300; ++n)
+        ASSERT_TRUE(reg.reconfigure([n](R::config_t &c)
+                                    { c.max_rate_hz.fill(n); },
+                                    2000000));
+    stop = true;
+    for (auto &t : readers)
+        t.join();
+    EXPECT_EQ(torn.load(), 0);
+}
+
+// More readers than Options<K>::config_readers: the extra one is refused
+// (and counted) until a slot frees up, instead of reading a made-up config.
+TEST(Config, ReaderSlotsExhaustedIsReported)
+{
+    R reg;
+    ASSERT_TRUE(reg.reconfigure([](R::config_t &c)
+                                { c.bridge(TEMP, false); }));
+    std::vector<R::config_reader_t> full(4);
+    for (auto &rd : full)
+    {
+        ASSERT_NE(rd.enter(reg.config_block()), nullptr);
+        rd.leave();
+    }
+    R::config_reader_t extra;
+    EXPECT_EQ(extra.enter(reg.config_block()), nullptr);
+    extra.leave(); // harmless
+    EXPECT_FALSE(extra.attached());
+    EXPECT_EQ(reg.config_block().refused(), 1u);
+
+    full.pop_back(); // frees a slot
+    const R::config_t *c = extra.enter(reg.config_block());
+    ASSERT_NE(c, nullptr);
+    EXPECT_FALSE(c->bridged(TEMP));
+    extra.leave();
+    EXPECT_TRUE(extra.attached());
+}
+
+// Readers keep announcing the config they last took: an update waits for a
+// reader that has not cycled since the swap before, even after its sink
+// threw, and goes through once the reader cycles again.
+TEST(Config, UpdatesWaitOnlyForReadersThatHaveNotCycled)
+{
+    R reg;
+    regbus::SyncCursor<R> cur;
+    reg.write<K::TEMP>(1.f);
+    EXPECT_THROW(regbus::sync_newer(reg, cur, [](auto, const auto &, uint32_t)
+                                    { throw std::runtime_error("peer gone"); }),
+                 std::runtime_error);
+    EXPECT_TRUE(reg.try_reconfigure([](R::config_t &) {}));  // the other buffer
+    EXPECT_FALSE(reg.try_reconfigure([](R::config_t &) {})); // the one the cursor last took
+    regbus::sync_newer(reg, cur, [](auto, const auto &, uint32_t) {});
+    EXPECT_TRUE(reg.try_reconfigure([](R::config_t &) {}));
+    EXPECT_EQ(reg.config_block().version(), 2u);
+
+    cur.config_reader().leave(); // idle: holds up nothing
+    EXPECT_TRUE(reg.try_reconfigure([](R::config_t &) {}));
+    EXPECT_TRUE(reg.try_reconfigure([](R::config_t &) {}));
+}
+
+// A reader without a slot is counted once, not once per attempt.
+TEST(Config, RefusedReaderIsCountedOnce)
+{
+    R reg;
+    std::vector<R::config_reader_t> full(4);
+    for (auto &rd : full)
+        ASSERT_NE(rd.enter(reg.config_block()), nullptr);
+    R::config_reader_t extra;
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(extra.enter(reg.config_block()), nullptr);
+    EXPECT_EQ(reg.config_block().refused(), 1u);
+}
+
+// A config max rate below the key's Traits min rate is clamped to the min rate.
+TEST(Config, MaxRateOverrideNeverUndercutsMinRate)
+{
+    R reg;
+    ASSERT_TRUE(reg.reconfigure([](R::config_t &c)
+                                { c.max_rate_hz[SPEED] = 2; }));
+    regbus::Packer<R> pk(1000000);
+    auto out = [](const uint8_t *, std::size_t) {};
+    for (uint64_t t = 0; t < 1000000; t += 10000) // 1 s at 100 Hz, SPEED changes every cycle
+    {
+        reg.write<K::SPEED>(float(t));
+        pk.cycle(reg, t, out);
+    }
+    EXPECT_GE(pk.stats(SPEED).sent, 19u);
+    EXPECT_LE(pk.stats(SPEED).sent, 21u);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <type_traits>
 
@@ -121,3 +122,75 @@ TEST(DBReg, DoubleReadStability)
     run.store(false, std::memory_order_relaxed);
     w.join();
 }
+
+// 4) Streaming-write / prefetching-read policy: same coherence guarantees.
+//    Thresholds lowered so a 64 KiB payload takes both non-plain paths.
+TEST(DBReg, LargePayloadCopyPolicyIsCoherent)
+{
+    struct Big
+    {
+        uint32_t w[16 * 1024];
+    };
+    using Reg = regbus::DBReg<Big, regbus::LargePayloadCopy<1024, 1024>>;
+    static Reg r;
+    static Big src, out;
+    std::atomic<bool> run{true};
+
+    std::thread w([&]
+                  {
+        uint32_t i = 1;
+        while (run.load(std::memory_order_relaxed)) {
+            src.w[0] = i;
+            src.w[8191] = i;
+            src.w[16383] = ~i;
+            r.write(src);
+            ++i;
+        } });
+
+    while (!r.read(out))
+        std::this_thread::yield();
+
+    for (int k = 0; k < 2000; ++k)
+    {
+        ASSERT_TRUE(r.read(out));
+        ASSERT_EQ(out.w[8191], out.w[0]) << "Torn read detected at iter " << k;
+        ASSERT_EQ(out.w[16383], ~out.w[0]) << "Torn read detected at iter " << k;
+    }
+
+    run.store(false, std::memory_order_relaxed);
+    w.join();
+}
+
+// 5) wait_until: woken per publish, returns the first value satisfying pred
+TEST(DBReg, WaitUntilPredicate)
+{
+    regbus::DBReg<float> volts;
+    float v = 0.f;
+    EXPECT_FALSE(volts.wait_until([](float x)
+                                  { return x < 10.5f; },
+                                  10000)); // never written: times out
+
+    std::atomic<int> evaluations{0};
+    std::thread w([&]
+                  {
+        for (int i = 0; i < 30; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(300));
+            volts.write(12.6f - 0.1f * float(i));
+        } });
+    const bool ok = volts.wait_until([&](float x)
+                                     {
+        ++evaluations;
+        return x < 10.5f; },
+                                     2000000, &v);
+    w.join();
+    EXPECT_TRUE(ok);
+    EXPECT_LT(v, 10.5f);
+    EXPECT_GT(v, 10.f);                // an early qualifying sample, not the last
+    EXPECT_LE(evaluations.load(), 30); // per publish, not per spin
+
+    // Already satisfied: returns without sleeping
+    EXPECT_TRUE(volts.wait_until([](float x)
+                                 { return x < 10.5f; },
+                                 1));
+}
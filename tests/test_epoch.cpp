@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "regbus/Epoch.hpp"
+
+TEST(Epoch, RegisterAndRelease)
+{
+    regbus::EpochDomain<2> d;
+    const std::size_t a = d.register_reader(), b = d.register_reader();
+    EXPECT_NE(a, b);
+    EXPECT_EQ(d.register_reader(), d.npos); // full
+    EXPECT_EQ(d.readers(), 2u);
+    d.unregister_reader(a);
+    EXPECT_EQ(d.register_reader(), a); // slot reused
+}
+
+TEST(Epoch, GracePeriodWaitsForOnlineReaders)
+{
+    regbus::EpochDomain<4> d;
+    EXPECT_TRUE(d.synchronize(1000)); // no readers
+
+    const std::size_t r = d.register_reader();
+    const uint64_t t = d.advance();
+    EXPECT_FALSE(d.quiesced(t)); // reader may still hold the old version
+    EXPECT_FALSE(d.wait(t, 2000));
+    d.quiescent(r);
+    EXPECT_TRUE(d.quiesced(t));
+
+    d.offline(r); // offline readers never block writers
+    EXPECT_TRUE(d.synchronize(1000));
+    d.online(r);
+    EXPECT_FALSE(d.synchronize(2000));
+}
+
+TEST(Epoch, SynchronizeReturnsAfterQuiescentPoint)
+{
+    regbus::EpochDomain<4> d;
+    const std::size_t r = d.register_reader();
+    std::thread t([&]
+                  {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        d.quiescent(r); });
+    EXPECT_TRUE(d.synchronize(2000000));
+    t.join();
+}
+
+// Writer swaps a table, waits a grace period and scribbles over the old
+// one; readers must never observe a scribbled table.
+TEST(Epoch, OldVersionUnusedAfterSynchronize)
+{
+    struct Table
+    {
+        int v[16];
+    };
+    static Table tables[2];
+    for (int &x : tables[0].v)
+        x = 1;
+    std::atomic<Table *> cur{&tables[0]};
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    regbus::EpochDomain<4> d;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+        readers.emplace_back([&]
+                             {
+            const std::size_t id = d.register_reader();
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const Table *t = cur.load(std::memory_order_acquire);
+                for (int x : t->v)
+                    if (x <= 0)
+                        bad.fetch_add(1);
+                d.quiescent(id);
+            }
+            d.unregister_reader(id); });
+
+    for (int gen = 2; gen < 200; ++gen)
+    {
+        Table *old = cur.load();
+        Table *next = old == &tables[0] ? &tables[1] : &tables[0];
+        for (int &x : next->v)
+            x = gen;
+        cur.store(next, std::memory_order_release);
+        ASSERT_TRUE(d.synchronize(2000000));
+        for (int &x : old->v)
+            x = -1; // repurposed
+    }
+    stop = true;
+    for (auto &t : readers)
+        t.join();
+    EXPECT_EQ(bad.load(), 0);
+}
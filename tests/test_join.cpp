@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#include "regbus/Join.hpp"
+
+enum class K : uint8_t
+{
+    IMU,
+    GNSS,
+    ODOM
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::IMU>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring;
+    static constexpr std::size_t depth = 64;
+};
+template <>
+struct Traits<K::GNSS>
+{
+    using type = double;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring;
+};
+template <>
+struct Traits<K::ODOM>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring;
+};
+
+using R = regbus::Registry<K, Traits, K::IMU, K::GNSS, K::ODOM>;
+using J = regbus::TimeJoin<R, K::IMU, K::GNSS, K::ODOM>;
+
+struct Row
+{
+    uint64_t t;
+    int imu;
+    bool has_gnss, has_odom;
+    double gnss;
+    float odom;
+};
+
+static auto collect(std::vector<Row> &rows)
+{
+    return [&rows](uint64_t t, const int &imu, const double *g, const float *o)
+    { rows.push_back({t, imu, g != nullptr, o != nullptr, g ? *g : 0.0, o ? *o : 0.f}); };
+}
+
+TEST(TimeJoin, PicksNearestWithinTolerance)
+{
+    R reg;
+    J join(30);
+    std::vector<Row> rows;
+
+    reg.write<K::GNSS>(0, 1.0);
+    reg.write<K::GNSS>(100, 2.0);
+    reg.write<K::ODOM>(45, 4.5f);
+    reg.write<K::ODOM>(200, 20.f);
+
+    reg.write<K::IMU>(10, 1);  // gnss 0 (10), odom none (35 > 30)
+    reg.write<K::IMU>(60, 2);  // gnss none (60 / 40), odom 45 (15)
+    reg.write<K::IMU>(90, 3);  // gnss 100 (10), odom 45? 45 > 30 -> none
+    EXPECT_EQ(join.poll(reg, 95, collect(rows)), 3u);
+    ASSERT_EQ(rows.size(), 3u);
+
+    EXPECT_TRUE(rows[0].has_gnss);
+    EXPECT_EQ(rows[0].gnss, 1.0);
+    EXPECT_FALSE(rows[0].has_odom);
+
+    EXPECT_FALSE(rows[1].has_gnss);
+    EXPECT_TRUE(rows[1].has_odom);
+    EXPECT_FLOAT_EQ(rows[1].odom, 4.5f);
+
+    EXPECT_TRUE(rows[2].has_gnss);
+    EXPECT_EQ(rows[2].gnss, 2.0);
+    EXPECT_FALSE(rows[2].has_odom);
+}
+
+TEST(TimeJoin, WaitsUntilMatchIsFinal)
+{
+    R reg;
+    J join(50);
+    std::vector<Row> rows;
+
+    reg.write<K::GNSS>(0, 1.0);
+    reg.write<K::ODOM>(0, 1.f);
+    reg.write<K::IMU>(40, 7);
+
+    // Neither GNSS nor ODOM has a sample after 40 and 40 + 50 not reached
+    EXPECT_EQ(join.poll(reg, 60, collect(rows)), 0u);
+
+    reg.write<K::GNSS>(45, 2.0); // closer than 0
+    EXPECT_EQ(join.poll(reg, 60, collect(rows)), 0u); // still waiting on ODOM
+
+    EXPECT_EQ(join.poll(reg, 91, collect(rows)), 1u); // ODOM timed out: keep the old one
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0].imu, 7);
+    EXPECT_EQ(rows[0].gnss, 2.0);
+    EXPECT_TRUE(rows[0].has_odom);
+    EXPECT_FLOAT_EQ(rows[0].odom, 1.f);
+
+    EXPECT_EQ(join.poll(reg, 1000, collect(rows)), 0u); // nothing new
+}
+
+TEST(TimeJoin, IncrementalAcrossPolls)
+{
+    R reg;
+    J join(5);
+    std::vector<Row> rows;
+    uint64_t now = 0;
+    // IMU at 1 kHz, GNSS at 10 Hz, ODOM at 100 Hz (times in ms for brevity)
+    for (int i = 0; i < 1000; ++i, ++now)
+    {
+        reg.write<K::IMU>(now, i);
+        if (now % 100 == 0)
+            reg.write<K::GNSS>(now, double(now));
+        if (now % 10 == 0)
+            reg.write<K::ODOM>(now, float(now));
+        join.poll(reg, now, collect(rows));
+    }
+    join.poll(reg, now + 10, collect(rows));
+
+    ASSERT_EQ(rows.size(), 1000u);
+    EXPECT_EQ(join.dropped(), 0u);
+    for (const Row &r : rows)
+    {
+        if (r.t >= 990) // no later GNSS/ODOM sample to match against
+            break;
+        const uint64_t dg = r.t % 100, dgo = std::min<uint64_t>(dg, 100 - dg);
+        EXPECT_EQ(r.has_gnss, dgo <= 5) << r.t;
+        if (r.has_gnss)
+        {
+            EXPECT_NEAR(r.gnss, double(r.t), 5.0) << r.t;
+        }
+        ASSERT_TRUE(r.has_odom); // 100 Hz odom: always within 5 ms
+        EXPECT_NEAR(r.odom, float(r.t), 5.f) << r.t;
+    }
+}
+
+TEST(TimeJoin, CountsReferenceOverrun)
+{
+    R reg;
+    J join(5);
+    std::vector<Row> rows;
+    reg.write<K::GNSS>(0, 0.0);
+    reg.write<K::ODOM>(0, 0.f);
+    for (uint64_t t = 0; t < 100; ++t)
+        reg.write<K::IMU>(t, int(t));
+    reg.write<K::GNSS>(1000, 0.0);
+    reg.write<K::ODOM>(1000, 0.f);
+
+    EXPECT_EQ(join.poll(reg, 1000, collect(rows)), 64u); // ring depth
+    EXPECT_EQ(join.dropped(), 36u);
+    EXPECT_EQ(rows.front().t, 36u);
+}
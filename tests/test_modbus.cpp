@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "regbus/ModbusTcp.hpp"
+
+enum class K : uint8_t
+{
+    TEMP,
+    SETPOINT,
+    CMD_START,
+    CMD_STOP,
+    CMD_MODE
+};
+
+struct Temp
+{
+    uint16_t a, b, c; // 3 registers
+};
+struct Setpoint
+{
+    uint32_t v; // 2 registers
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::TEMP>
+{
+    using type = Temp;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::SETPOINT>
+{
+    using type = Setpoint;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr bool modbus_writable = true;
+};
+template <>
+struct Traits<K::CMD_START>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+template <>
+struct Traits<K::CMD_STOP>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+struct Mode
+{
+    int m; // not constructible from bool: coil writes are refused
+};
+template <>
+struct Traits<K::CMD_MODE>
+{
+    using type = Mode;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::TEMP, K::CMD_START, K::SETPOINT, K::CMD_STOP, K::CMD_MODE>;
+using S = regbus::ModbusServer<R>;
+
+static_assert(S::register_of<K::TEMP>() == 0, "");
+static_assert(S::register_of<K::SETPOINT>() == 3, "");
+static_assert(S::coil_of<K::CMD_START>() == 0, "");
+static_assert(S::coil_of<K::CMD_STOP>() == 1, "");
+static_assert(S::register_count() == 5 && S::coil_count() == 3, "");
+
+TEST(Modbus, ReadInputRegistersSpansKeys)
+{
+    R r;
+    S s(r);
+    r.write<K::TEMP>({1, 2, 3});
+    r.write<K::SETPOINT>({0x11223344});
+
+    const uint8_t req[] = {S::READ_INPUT, 0, 1, 0, 4}; // TEMP.b .. SETPOINT
+    uint8_t out[256];
+    ASSERT_EQ(s.handle_pdu(req, sizeof(req), out), 10u);
+    EXPECT_EQ(out[1], 8);
+
+    // Big-endian registers; the uint32_t keeps host word order (little-endian in CI)
+    const uint8_t expect[8] = {0x00, 0x02, 0x00, 0x03, 0x33, 0x44, 0x11, 0x22};
+    EXPECT_EQ(0, std::memcmp(out + 2, expect, 8));
+}
+
+TEST(Modbus, ExceptionsForBadRequests)
+{
+    R r;
+    S s(r);
+    uint8_t out[256];
+
+    const uint8_t past_end[] = {S::READ_HOLDING, 0, 4, 0, 2};
+    ASSERT_EQ(s.handle_pdu(past_end, sizeof(past_end), out), 2u);
+    EXPECT_EQ(out[0], S::READ_HOLDING | 0x80);
+    EXPECT_EQ(out[1], S::ILLEGAL_ADDRESS);
+
+    const uint8_t bad_fc[] = {0x2B, 0, 0, 0, 1};
+    ASSERT_EQ(s.handle_pdu(bad_fc, sizeof(bad_fc), out), 2u);
+    EXPECT_EQ(out[1], S::ILLEGAL_FUNCTION);
+    ASSERT_EQ(s.handle_pdu(bad_fc, 2, out), 2u); // short, unknown function
+    EXPECT_EQ(out[1], S::ILLEGAL_FUNCTION);
+    const uint8_t short_rd[] = {S::READ_HOLDING, 0};
+    ASSERT_EQ(s.handle_pdu(short_rd, sizeof(short_rd), out), 2u);
+    EXPECT_EQ(out[1], S::ILLEGAL_VALUE);
+
+    // TEMP is read-only
+    const uint8_t ro[] = {S::WRITE_REGISTER, 0, 0, 0x12, 0x34};
+    ASSERT_EQ(s.handle_pdu(ro, sizeof(ro), out), 2u);
+    EXPECT_EQ(out[1], S::ILLEGAL_ADDRESS);
+    EXPECT_FALSE(r.has<K::TEMP>());
+}
+
+TEST(Modbus, PartialHoldingWritePatchesLatestValue)
+{
+    R r;
+    S s(r);
+    r.write<K::SETPOINT>({0});
+    uint8_t out[256];
+
+    const uint8_t req[] = {S::WRITE_REGISTER, 0, 4, 0xAB, 0xCD}; // second word of SETPOINT
+    ASSERT_EQ(s.handle_pdu(req, sizeof(req), out), 5u);
+    Setpoint got{};
+    ASSERT_TRUE(r.read<K::SETPOINT>(got));
+    EXPECT_EQ(got.v, 0xABCD0000u); // high word on a little-endian host
+
+    const uint8_t both[] = {S::WRITE_REGISTERS, 0, 3, 0, 2, 4, 0x56, 0x78, 0x12, 0x34};
+    ASSERT_EQ(s.handle_pdu(both, sizeof(both), out), 5u);
+    ASSERT_TRUE(r.read<K::SETPOINT>(got));
+    EXPECT_EQ(got.v, 0x12345678u);
+}
+
+TEST(Modbus, CoilsPostAndReportPending)
+{
+    R r;
+    S s(r);
+    uint8_t out[256];
+
+    const uint8_t on[] = {S::WRITE_COIL, 0, 1, 0xFF, 0x00};
+    ASSERT_EQ(s.handle_pdu(on, sizeof(on), out), 5u);
+    EXPECT_TRUE(r.pending<K::CMD_STOP>());
+    EXPECT_FALSE(r.pending<K::CMD_START>());
+
+    const uint8_t rd[] = {S::READ_COILS, 0, 0, 0, 2};
+    ASSERT_EQ(s.handle_pdu(rd, sizeof(rd), out), 3u);
+    EXPECT_EQ(out[2], 0x02);
+
+    bool v = false;
+    EXPECT_TRUE(r.consume<K::CMD_STOP>(v));
+    EXPECT_TRUE(v);
+
+    // Coils 0..2 ON, but CMD_MODE cannot take a coil: nothing is posted
+    const uint8_t many[] = {S::WRITE_COILS, 0, 0, 0, 3, 1, 0x07};
+    ASSERT_EQ(s.handle_pdu(many, sizeof(many), out), 2u);
+    EXPECT_EQ(out[1], S::ILLEGAL_ADDRESS);
+    EXPECT_FALSE(r.pending<K::CMD_START>());
+    EXPECT_FALSE(r.pending<K::CMD_STOP>());
+}
+
+TEST(Modbus, ProcessHandlesBatchedAndPartialAdus)
+{
+    R r;
+    S s(r);
+    r.write<K::TEMP>({7, 8, 9});
+
+    // Two back-to-back requests followed by half of a third
+    uint8_t in[12 * 3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const uint8_t adu[12] = {0, uint8_t(i), 0, 0, 0, 6, 1, S::READ_HOLDING, 0, 0, 0, 3};
+        std::memcpy(in + 12 * i, adu, 12);
+    }
+    uint8_t out[4 * S::max_adu];
+    std::size_t out_len = 0, n = 0;
+    EXPECT_EQ(s.process(in, 30, out, sizeof(out), &out_len, &n), 24u);
+    EXPECT_EQ(n, 2u);
+    EXPECT_EQ(out_len, 2u * (7 + 2 + 6));
+    EXPECT_EQ(out[1], 0);  // transaction ids echoed
+    EXPECT_EQ(out[16], 1);
+}
+
+TEST(ModbusTcp, LoopbackClient)
+{
+    R r;
+    r.write<K::TEMP>({100, 200, 300});
+
+    regbus::ModbusTcpGateway<R> gw(r);
+    ASSERT_TRUE(gw.listen(0, "127.0.0.1"));
+    const uint16_t port = gw.port();
+    ASSERT_NE(port, 0);
+
+    std::atomic<bool> run{true};
+    std::thread srv([&]
+                    { while (run.load()) gw.poll_once(10); });
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr);
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr *>(&sa), sizeof(sa)), 0);
+
+    // Pipelined: read TEMP (holding) + write coil CMD_START in one send
+    const uint8_t req[] = {0, 1, 0, 0, 0, 6, 1, S::READ_HOLDING, 0, 0, 0, 3,
+                           0, 2, 0, 0, 0, 6, 1, S::WRITE_COIL, 0, 0, 0xFF, 0x00};
+    ASSERT_EQ(::send(fd, req, sizeof(req), 0), ssize_t(sizeof(req)));
+
+    const std::size_t want = (7 + 2 + 6) + (7 + 5);
+    uint8_t resp[64];
+    std::size_t got = 0;
+    while (got < want)
+    {
+        ssize_t k = ::recv(fd, resp + got, sizeof(resp) - got, 0);
+        ASSERT_GT(k, 0);
+        got += std::size_t(k);
+    }
+    ::close(fd);
+    run.store(false);
+    srv.join();
+
+    EXPECT_EQ(resp[7], S::READ_HOLDING);
+    EXPECT_EQ(resp[8], 6);
+    EXPECT_EQ(resp[9] << 8 | resp[10], 100); // big-endian registers
+    EXPECT_EQ(resp[13] << 8 | resp[14], 300);
+    EXPECT_EQ(resp[15 + 7], S::WRITE_COIL);
+    EXPECT_TRUE(r.pending<K::CMD_START>());
+}
+
+// A peer that sends requests but never reads the responses must not stall
+// the gateway for everyone else.
+TEST(ModbusTcp, SlowPeerDoesNotStallOthers)
+{
+    R r;
+    r.write<K::TEMP>({1, 2, 3});
+    regbus::ModbusTcpGateway<R> gw(r);
+    ASSERT_TRUE(gw.listen(0, "127.0.0.1"));
+    std::atomic<bool> run{true};
+    std::thread srv([&]
+                    { while (run.load()) gw.poll_once(10); });
+
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(gw.port());
+    ::inet_pton(AF_INET, "127.0.0.1", &sa.sin_addr);
+
+    int slow = ::socket(AF_INET, SOCK_STREAM, 0);
+    int small = 4096;
+    ::setsockopt(slow, SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+    ASSERT_EQ(::connect(slow, reinterpret_cast<sockaddr *>(&sa), sizeof(sa)), 0);
+    ::fcntl(slow, F_SETFL, ::fcntl(slow, F_GETFL, 0) | O_NONBLOCK);
+    uint8_t burst[12 * 256];
+    for (int i = 0; i < 256; ++i)
+    {
+        const uint8_t adu[12] = {0, 0, 0, 0, 0, 6, 1, S::READ_HOLDING, 0, 0, 0, 5};
+        std::memcpy(burst + 12 * i, adu, 12);
+    }
+    for (int i = 0; i < 2000; ++i) // ~6 MB of requests; stops when the gateway stops reading
+        if (::send(slow, burst, sizeof(burst), MSG_NOSIGNAL) < 0)
+            break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(300)); // gateway fills the slow peer's buffers
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    timeval tv{2, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr *>(&sa), sizeof(sa)), 0);
+    const uint8_t req[] = {0, 9, 0, 0, 0, 6, 1, S::READ_HOLDING, 0, 0, 0, 1};
+    ASSERT_EQ(::send(fd, req, sizeof(req), 0), ssize_t(sizeof(req)));
+    uint8_t resp[16];
+    std::size_t got = 0;
+    while (got < 11)
+    {
+        ssize_t k = ::recv(fd, resp + got, sizeof(resp) - got, 0);
+        if (k <= 0)
+            break; // timed out
+        got += std::size_t(k);
+    }
+    ::close(fd);
+    ::close(slow);
+    run.store(false);
+    srv.join();
+    ASSERT_GE(got, 11u) << "gateway stalled behind the slow peer";
+    EXPECT_EQ(resp[1], 9);
+}
@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "regbus/Packer.hpp"
+
+enum class K : uint8_t
+{
+    FAST,
+    SLOW,
+    HEARTBEAT,
+    CMD_GO,
+    HI,
+    LO,
+    HUGE
+};
+
+struct Big
+{
+    uint32_t v[24]; // 96 bytes -> 104-byte records
+};
+struct Beat
+{
+    uint32_t n;
+};
+struct Huge
+{
+    uint8_t b[300]; // larger than the test MTU
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::FAST>
+{
+    using type = Big;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr uint32_t priority = 3;
+};
+template <>
+struct Traits<K::SLOW>
+{
+    using type = Big;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr uint32_t max_rate_hz = 10;
+};
+template <>
+struct Traits<K::HEARTBEAT>
+{
+    using type = Beat;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr uint32_t min_rate_hz = 1;
+};
+template <>
+struct Traits<K::CMD_GO>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+// Same size, no rate caps: only priority differs
+template <>
+struct Traits<K::HI>
+{
+    using type = Big;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr uint32_t priority = 3;
+};
+template <>
+struct Traits<K::LO>
+{
+    using type = Big;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::HUGE>
+{
+    using type = Huge;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+using R = regbus::Registry<K, Traits, K::FAST, K::SLOW, K::HEARTBEAT, K::CMD_GO, K::HI, K::LO, K::HUGE>;
+constexpr std::size_t MTU = 256;
+using P = regbus::Packer<R, MTU>;
+
+// In-memory sink: keeps every frame.
+struct MemSink
+{
+    std::vector<std::vector<uint8_t>> frames;
+    void operator()(const uint8_t *p, std::size_t n) { frames.emplace_back(p, p + n); }
+
+    // Decode record headers: returns key indices in send order
+    std::vector<uint16_t> keys() const
+    {
+        std::vector<uint16_t> out;
+        for (auto &f : frames)
+        {
+            for (std::size_t off = 0; off < f.size();)
+            {
+                uint16_t key = uint16_t(f[off] | f[off + 1] << 8);
+                uint16_t len = uint16_t(f[off + 2] | f[off + 3] << 8);
+                out.push_back(key);
+                off += P::header_bytes + len;
+            }
+        }
+        return out;
+    }
+};
+
+TEST(Packer, SendsOnlyChangedKeysAndRespectsMtu)
+{
+    R r;
+    P p(1000000);
+    MemSink sink;
+
+    r.write<K::FAST>({});
+    r.write<K::SLOW>({});
+    EXPECT_EQ(p.cycle(r, 0, sink), 2u);
+    for (auto &f : sink.frames)
+        EXPECT_LE(f.size(), MTU);
+
+    // Nothing changed -> nothing sent (heartbeat not written yet)
+    sink.frames.clear();
+    EXPECT_EQ(p.cycle(r, 1000, sink), 0u);
+    EXPECT_TRUE(sink.frames.empty());
+}
+
+TEST(Packer, RecordCarriesSeqAndPayload)
+{
+    R r;
+    P p(1000000);
+    MemSink sink;
+    r.write<K::HEARTBEAT>({77});
+    uint32_t seq = r.seq<K::HEARTBEAT>();
+    ASSERT_EQ(p.cycle(r, 0, sink), 1u);
+    ASSERT_EQ(sink.frames.size(), 1u);
+    const auto &f = sink.frames[0];
+    ASSERT_EQ(f.size(), P::header_bytes + sizeof(Beat));
+    EXPECT_EQ(f[0], R::index<K::HEARTBEAT>());
+    uint32_t s = 0;
+    std::memcpy(&s, &f[4], 4); // little-endian host in CI
+    EXPECT_EQ(s, seq);
+    Beat b{};
+    std::memcpy(&b, &f[P::header_bytes], sizeof(b));
+    EXPECT_EQ(b.n, 77u);
+}
+
+TEST(Packer, BudgetLimitsBytesAndMaxRateCaps)
+{
+    R r;
+    // 10 kB/s with a small burst allowance
+    P p(10000, 64, 208);
+    MemSink sink;
+
+    uint64_t now = 0;
+    p.cycle(r, now, sink); // start clock
+    for (int i = 0; i < 100; ++i)
+    {
+        now += 10000; // 10 ms -> 100 bytes of budget per cycle
+        r.write<K::FAST>({});
+        r.write<K::SLOW>({});
+        p.cycle(r, now, sink);
+    }
+
+    std::size_t bytes = 0;
+    for (auto &f : sink.frames)
+        bytes += f.size();
+    EXPECT_LE(bytes, 10000u + 208u); // 1 s at 10 kB/s + initial burst
+    EXPECT_GE(bytes, 9000u);
+
+    // SLOW is capped at 10 Hz; FAST takes the rest of the link.
+    EXPECT_LE(p.stats(R::index<K::SLOW>()).sent, 11u);
+    EXPECT_GT(p.stats(R::index<K::FAST>()).sent, p.stats(R::index<K::SLOW>()).sent);
+}
+
+// Two always-changing keys that differ only in priority share a link that
+// carries about one record per cycle in proportion to their weights.
+TEST(Packer, PriorityAloneSetsShare)
+{
+    R r;
+    P p(10400, 64, 104); // ~one 104-byte record per 10 ms cycle
+    MemSink sink;
+    uint64_t now = 0;
+    p.cycle(r, now, sink);
+    for (int i = 0; i < 400; ++i)
+    {
+        now += 10000;
+        r.write<K::HI>({});
+        r.write<K::LO>({});
+        p.cycle(r, now, sink);
+    }
+    const double hi = double(p.stats(R::index<K::HI>()).bytes);
+    const double lo = double(p.stats(R::index<K::LO>()).bytes);
+    ASSERT_GT(lo, 0.0);
+    EXPECT_NEAR(hi / (hi + lo), 0.75, 0.08);
+}
+
+TEST(Packer, OversizedKeysAreSkippedAndZeroQuantumWorks)
+{
+    R r;
+    P p(1000000, 0); // no idle credit: still makes progress
+    MemSink sink;
+    EXPECT_FALSE(p.sendable(R::index<K::HUGE>()));
+    EXPECT_FALSE(p.sendable(R::index<K::CMD_GO>()));
+    EXPECT_TRUE(p.sendable(R::index<K::FAST>()));
+    r.write<K::HUGE>({});
+    r.write<K::FAST>({});
+    EXPECT_EQ(p.cycle(r, 0, sink), 1u);
+    EXPECT_EQ(sink.keys(), (std::vector<uint16_t>{uint16_t(R::index<K::FAST>())}));
+
+    // The skipped change is counted once, and again for the next change
+    EXPECT_EQ(p.stats(R::index<K::HUGE>()).dropped, 1u);
+    p.cycle(r, 1000, sink);
+    EXPECT_EQ(p.dropped(), 1u);
+    r.write<K::HUGE>({});
+    p.cycle(r, 2000, sink);
+    EXPECT_EQ(p.dropped(), 2u);
+    EXPECT_EQ(p.stats(R::index<K::HUGE>()).sent, 0u);
+}
+
+TEST(Packer, MinRateResendsUnchangedValue)
+{
+    R r;
+    P p(1000000);
+    MemSink sink;
+    r.write<K::HEARTBEAT>({1});
+
+    uint64_t now = 0;
+    for (int i = 0; i <= 50; ++i, now += 100000) // 5 s at 10 Hz cycles
+        p.cycle(r, now, sink);
+
+    // Sent once for the change, then once per second
+    auto sent = p.stats(R::index<K::HEARTBEAT>()).sent;
+    EXPECT_GE(sent, 5u);
+    EXPECT_LE(sent, 7u);
+    EXPECT_NEAR(p.achieved_hz(R::index<K::HEARTBEAT>(), now), 1.0, 0.5);
+}
+
+TEST(Packer, MaxRateDefersButDoesNotDrop)
+{
+    R r;
+    P p(1000000);
+    MemSink sink;
+    r.write<K::SLOW>({{1}});
+    p.cycle(r, 0, sink);
+    r.write<K::SLOW>({{2}});
+    EXPECT_EQ(p.cycle(r, 50000, sink), 0u);  // 50 ms < 100 ms gap
+    EXPECT_EQ(p.cycle(r, 100000, sink), 1u); // latest value goes out
+    auto keys = sink.keys();
+    ASSERT_EQ(keys.size(), 2u);
+    Big b{};
+    std::memcpy(&b, &sink.frames.back()[P::header_bytes], sizeof(b));
+    EXPECT_EQ(b.v[0], 2u);
+}
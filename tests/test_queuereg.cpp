@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    JOBS,
+    FLAG
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::JOBS>
+{
+    using type = uint32_t;
+    static constexpr regbus::Kind kind = regbus::Kind::Queue;
+    static constexpr std::size_t capacity = 8;
+    static constexpr std::size_t consumers = 4;
+};
+template <>
+struct Traits<K::FLAG>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::JOBS, K::FLAG>;
+
+TEST(QueueReg, FifoFullAndBatch)
+{
+    R r;
+    EXPECT_FALSE(r.pending<K::JOBS>());
+    for (uint32_t i = 0; i < 8; ++i)
+        EXPECT_TRUE(r.push<K::JOBS>(i));
+    EXPECT_FALSE(r.push<K::JOBS>(99)); // full
+    EXPECT_EQ(r.queue<K::JOBS>().rejected(), 1u);
+    EXPECT_EQ(r.queue<K::JOBS>().size(), 8u);
+
+    uint32_t v = 0;
+    EXPECT_TRUE(r.pop<K::JOBS>(v, 1));
+    EXPECT_EQ(v, 0u);
+
+    uint32_t out[16];
+    EXPECT_EQ(r.pop_batch<K::JOBS>(out, 5, 2), 5u);
+    for (uint32_t i = 0; i < 5; ++i)
+        EXPECT_EQ(out[i], i + 1);
+    EXPECT_EQ(r.pop_batch<K::JOBS>(out, 16, 2), 2u); // only what is there
+    EXPECT_EQ(r.pop_batch<K::JOBS>(out, 16, 2), 0u);
+
+    EXPECT_EQ(r.queue<K::JOBS>().claimed(1), 1u);
+    EXPECT_EQ(r.queue<K::JOBS>().claimed(2), 7u);
+    EXPECT_EQ(r.queue<K::JOBS>().claims(2), 2u);
+
+    // Wraps cleanly
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(r.push<K::JOBS>(i));
+        EXPECT_TRUE(r.pop<K::JOBS>(v));
+        EXPECT_EQ(v, i);
+    }
+}
+
+// 2 producers, 4 consumers (mixed single/batched): every job taken exactly once
+TEST(QueueReg, MpmcExactlyOnce)
+{
+    regbus::QueueReg<uint32_t, 16, 4> q;
+    constexpr uint32_t per = 5000;
+    std::vector<std::atomic<uint8_t>> seen(2 * per);
+    std::atomic<uint32_t> taken{0};
+
+    auto producer = [&](uint32_t base)
+    {
+        for (uint32_t i = 0; i < per; ++i)
+            while (!q.push(base + i))
+                std::this_thread::yield();
+    };
+    auto consumer = [&](std::size_t id)
+    {
+        uint32_t buf[4];
+        while (taken.load() < 2 * per)
+        {
+            const std::size_t n = q.pop_batch(buf, id % 2 ? 4 : 1, id);
+            for (std::size_t i = 0; i < n; ++i)
+                seen[buf[i]].fetch_add(1);
+            taken.fetch_add(uint32_t(n));
+            if (n == 0)
+                std::this_thread::yield();
+        }
+    };
+
+    std::vector<std::thread> th;
+    for (std::size_t c = 0; c < 4; ++c)
+        th.emplace_back(consumer, c);
+    th.emplace_back(producer, 0);
+    th.emplace_back(producer, per);
+    for (auto &t : th)
+        t.join();
+
+    for (auto &s : seen)
+        ASSERT_EQ(s.load(), 1);
+    uint64_t total = 0;
+    for (std::size_t c = 0; c < 4; ++c)
+        total += q.claimed(c);
+    EXPECT_EQ(total, 2u * per);
+    EXPECT_EQ(q.size(), 0u);
+}
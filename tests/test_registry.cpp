@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cstring>
 
 #include "regbus/Registry.hpp"
 
@@ -6,7 +7,8 @@ enum class K : uint8_t
 {
     A,
     B,
-    CMD_GO
+    CMD_GO,
+    FRAME
 };
 
 struct AType
@@ -39,6 +41,18 @@ struct Traits<K::CMD_GO>
     static constexpr regbus::Kind kind = regbus::Kind::Cmd;
 };
 
+struct Frame
+{
+    uint8_t px[64 * 1024];
+};
+template <>
+struct Traits<K::FRAME>
+{
+    using type = Frame;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    using copy = regbus::LargePayloadCopy<32 * 1024, 32 * 1024>; // per-key copy policy
+};
+
 using R = regbus::Registry<K, Traits, K::A, K::B, K::CMD_GO>;
 
 TEST(Registry, DataRoundTrip)
@@ -73,3 +87,69 @@ TEST(Registry, SizeBudgetIsSmall)
     // Ensure we stay tiny; this catches accidental bloat.
     static_assert(R::bytes() <= 4096, "Registry too large");
 }
+
+TEST(Registry, PerKeyCopyPolicy)
+{
+    using RF = regbus::Registry<K, Traits, K::A, K::FRAME>;
+    static RF r;
+    static Frame f, out;
+    for (std::size_t i = 0; i < sizeof f.px; ++i)
+        f.px[i] = uint8_t(i * 7);
+    r.write<K::FRAME>(f);
+    ASSERT_TRUE(r.read<K::FRAME>(out));
+    EXPECT_EQ(std::memcmp(f.px, out.px, sizeof f.px), 0);
+}
+
+// Generation counters: opt-in through Options, registry-wide and per group
+enum class GK : uint8_t
+{
+    A,
+    B,
+    C,
+    CMD
+};
+template <GK K>
+struct GTraits
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+    static constexpr std::size_t group = K == GK::C ? 1 : 0;
+};
+template <>
+struct GTraits<GK::CMD>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd; // no group: global only
+};
+template <>
+struct regbus::Options<GK>
+{
+    static constexpr bool generation = true;
+    static constexpr std::size_t groups = 2;
+};
+
+TEST(Registry, GenerationCounters)
+{
+    using GR = regbus::Registry<GK, GTraits, GK::A, GK::B, GK::C, GK::CMD>;
+    static_assert(!R::has_generation, "off by default");
+    GR r;
+    const uint64_t g0 = r.generation();
+    static_assert(alignof(regbus::detail::GenCounter) == 64, "one counter per line");
+
+    r.write<GK::A>(1);
+    r.write<GK::B>(2);
+    EXPECT_EQ(r.generation(), g0 + 2);
+    EXPECT_EQ(r.generation(0), 2u);
+    EXPECT_EQ(r.generation(1), 0u);
+
+    r.write<GK::C>(3);
+    r.post<GK::CMD>(4);
+    EXPECT_EQ(r.generation(), g0 + 4);
+    EXPECT_EQ(r.generation(1), 1u);
+    EXPECT_EQ(r.generation(0), 2u);
+
+    int v;
+    r.consume<GK::CMD>(v); // reads do not count
+    r.read<GK::A>(v);
+    EXPECT_EQ(r.generation(), g0 + 4);
+}
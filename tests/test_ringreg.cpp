@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    GPS_ALT,
+    IMU,
+    MODE
+};
+
+struct Vec2
+{
+    float x, y;
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::GPS_ALT>
+{
+    using type = double;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring;
+    static constexpr std::size_t depth = 8;
+};
+template <>
+struct Traits<K::IMU>
+{
+    using type = Vec2;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring; // default depth
+};
+template <>
+struct Traits<K::MODE>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+using R = regbus::Registry<K, Traits, K::GPS_ALT, K::IMU, K::MODE>;
+using regbus::At;
+
+TEST(RingReg, EmptyAndLatest)
+{
+    regbus::RingReg<int, 4> r;
+    int v = 0;
+    uint64_t t = 0;
+    EXPECT_FALSE(r.latest(v));
+    regbus::RingReg<int, 4>::Bracket b;
+    EXPECT_EQ(r.read_at(10, b), At::Empty);
+
+    r.write(100, 7);
+    r.write(200, 8);
+    ASSERT_TRUE(r.latest(v, &t));
+    EXPECT_EQ(v, 8);
+    EXPECT_EQ(t, 200u);
+    EXPECT_EQ(r.count(), 2u);
+}
+
+TEST(RingReg, BracketAndExactHit)
+{
+    regbus::RingReg<int, 16> r;
+    for (int i = 0; i < 10; ++i)
+        r.write(uint64_t(i) * 100, i);
+
+    regbus::RingReg<int, 16>::Bracket b;
+    ASSERT_EQ(r.read_at(450, b), At::Ok);
+    EXPECT_EQ(b.t0, 400u);
+    EXPECT_EQ(b.t1, 500u);
+    EXPECT_EQ(b.v0, 4);
+    EXPECT_EQ(b.v1, 5);
+
+    ASSERT_EQ(r.read_at(300, b), At::Ok);
+    EXPECT_EQ(b.t0, 300u);
+    EXPECT_EQ(b.t1, 300u);
+    EXPECT_EQ(b.v0, 3);
+
+    ASSERT_EQ(r.read_at(900, b), At::Ok); // newest
+    EXPECT_EQ(b.v1, 9);
+    EXPECT_EQ(r.read_at(901, b), At::After);
+}
+
+TEST(RingReg, OverwrittenSamplesAreBefore)
+{
+    regbus::RingReg<int, 4> r;
+    for (int i = 0; i < 10; ++i)
+        r.write(uint64_t(i) * 10, i);
+    EXPECT_EQ(r.oldest(), 6u);
+
+    regbus::RingReg<int, 4>::Bracket b;
+    EXPECT_EQ(r.read_at(55, b), At::Before);
+    ASSERT_EQ(r.read_at(60, b), At::Ok);
+    EXPECT_EQ(b.v0, 6);
+
+    uint64_t t;
+    int v;
+    EXPECT_FALSE(r.at(5, t, &v)); // lapped
+    ASSERT_TRUE(r.at(7, t, &v));
+    EXPECT_EQ(v, 7);
+    EXPECT_EQ(t, 70u);
+}
+
+TEST(RingReg, LinearInterpolation)
+{
+    regbus::RingReg<double, 8> r;
+    r.write(1000, 10.0);
+    r.write(2000, 20.0);
+    double v = 0;
+    ASSERT_EQ(r.read_at(1250, v), At::Ok);
+    EXPECT_DOUBLE_EQ(v, 12.5);
+    ASSERT_EQ(r.read_at(2000, v), At::Ok);
+    EXPECT_DOUBLE_EQ(v, 20.0);
+}
+
+TEST(RingReg, UnsignedInterpolationDecreasing)
+{
+    regbus::RingReg<uint32_t, 8> r;
+    r.write(1000, 10);
+    r.write(2000, 6);
+    uint32_t v = 0;
+    ASSERT_EQ(r.read_at(1500, v), At::Ok);
+    EXPECT_EQ(v, 8u);
+    ASSERT_EQ(r.read_at(1900, v), At::Ok);
+    EXPECT_EQ(v, 6u); // 6.4 rounds to nearest
+
+    regbus::RingReg<int8_t, 8> s;
+    s.write(0, -100);
+    s.write(1000, 100);
+    int8_t w = 0;
+    ASSERT_EQ(s.read_at(250, w), At::Ok);
+    EXPECT_EQ(w, -50);
+}
+
+TEST(RingReg, RegistryCustomInterpolator)
+{
+    R reg;
+    reg.write<K::IMU>(0, Vec2{0.f, 10.f});
+    reg.write<K::IMU>(100, Vec2{1.f, 20.f});
+
+    auto lerp2 = [](const Vec2 &a, const Vec2 &b, double al)
+    { return Vec2{float(a.x + (b.x - a.x) * al), float(a.y + (b.y - a.y) * al)}; };
+    Vec2 v{};
+    ASSERT_EQ(reg.read_at<K::IMU>(50, v, lerp2), At::Ok);
+    EXPECT_FLOAT_EQ(v.x, 0.5f);
+    EXPECT_FLOAT_EQ(v.y, 15.f);
+
+    R::bracket_t<K::IMU> b;
+    ASSERT_EQ(reg.read_at<K::IMU>(25, b), At::Ok);
+    EXPECT_EQ(b.t0, 0u);
+    EXPECT_EQ(b.t1, 100u);
+
+    EXPECT_EQ(reg.history<K::GPS_ALT>().depth, 8u);
+    EXPECT_EQ(reg.history<K::IMU>().depth, 16u);
+
+    // Slow sensor sampled at a fast sensor's timestamp
+    reg.write<K::GPS_ALT>(0, 100.0);
+    reg.write<K::GPS_ALT>(200000, 120.0);
+    double alt = 0;
+    ASSERT_EQ(reg.read_at<K::GPS_ALT>(50000, alt), At::Ok);
+    EXPECT_DOUBLE_EQ(alt, 105.0);
+
+    reg.write<K::MODE>(3); // Data keys unaffected
+    int m = 0;
+    EXPECT_TRUE(reg.read<K::MODE>(m));
+    EXPECT_EQ(m, 3);
+}
+
+// Value encodes its timestamp; a reader racing the writer must never see a
+// bracket whose values disagree with their timestamps.
+TEST(RingReg, ConcurrentReadAtIsCoherent)
+{
+    struct S
+    {
+        uint64_t t, a, b, c;
+    };
+    static regbus::RingReg<S, 64> r;
+    constexpr uint64_t reads = 2000; // coherent reads wanted while writes race
+    std::atomic<bool> stop{false}, go{false};
+    std::atomic<uint64_t> bad{0}, ok{0};
+
+    // The reader decides when enough happened; the deadline only bounds a hang
+    std::thread w([&]
+                  {
+        while (!go.load())
+            std::this_thread::yield();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+        for (uint64_t t = 1; ok.load() < reads && std::chrono::steady_clock::now() < deadline; ++t)
+            r.write(t * 10, S{t * 10, t, t, t});
+        stop = true; });
+
+    std::thread rd([&]
+                   {
+        regbus::RingReg<S, 64>::Bracket b;
+        uint64_t probe = 0, n = 0;
+        go = true;
+        while (!stop.load())
+        {
+            uint64_t tl = 0;
+            S s;
+            if (!r.latest(s, &tl))
+                continue;
+            probe = tl > 200 ? tl - 200 + (n++ % 7) : tl;
+            if (r.read_at(probe, b) != At::Ok)
+                continue;
+            if (b.v0.t != b.t0 || b.v1.t != b.t1 || b.t0 > probe || b.t1 < probe ||
+                b.v0.a != b.v0.c || b.v1.a != b.v1.c)
+                ++bad;
+            else
+                ++ok;
+        } });
+
+    w.join();
+    rd.join();
+    EXPECT_EQ(bad.load(), 0u);
+    EXPECT_GE(ok.load(), reads);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    STATUS,
+    FW_VERSION,
+    COUNT
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::STATUS>
+{
+    using type = regbus::FixedString<256>;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::FW_VERSION>
+{
+    using type = regbus::FixedString<16>;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::COUNT>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+using R = regbus::Registry<K, Traits, K::STATUS, K::FW_VERSION, K::COUNT>;
+
+TEST(StrReg, FixedStringBasics)
+{
+    regbus::FixedString<8> s;
+    EXPECT_TRUE(s.empty());
+    s.assign("hello");
+    EXPECT_EQ(s.view(), "hello");
+    EXPECT_EQ(s.size(), 5u);
+    regbus::FixedString<8> t("hello world"); // truncated to capacity
+    EXPECT_EQ(t.view(), "hello wo");
+    EXPECT_NE(s, t);
+    static_assert(std::is_trivially_copyable<regbus::FixedString<8>>::value, "");
+}
+
+TEST(StrReg, RegistryReadWrite)
+{
+    R r;
+    regbus::FixedString<256> out;
+    EXPECT_FALSE(r.read<K::STATUS>(out));
+
+    r.write<K::STATUS>("motor armed");
+    uint32_t seq = 0;
+    ASSERT_TRUE(r.read<K::STATUS>(out, &seq));
+    EXPECT_EQ(out.view(), "motor armed");
+    EXPECT_EQ(seq, 1u);
+    EXPECT_EQ(r.seq<K::STATUS>(), 1u);
+
+    r.write<K::STATUS>(regbus::FixedString<256>("idle")); // value_t overload
+    ASSERT_TRUE(r.read<K::STATUS>(out));
+    EXPECT_EQ(out.view(), "idle");
+
+    r.write<K::FW_VERSION>("v1.2.3-rc1+build.4567"); // longer than 16
+    regbus::FixedString<16> fw;
+    ASSERT_TRUE(r.read<K::FW_VERSION>(fw));
+    EXPECT_EQ(fw.view(), "v1.2.3-rc1+build");
+
+    std::string seen;
+    ASSERT_TRUE(r.visit<K::STATUS>([&](std::string_view v)
+                                   { seen.assign(v); }));
+    EXPECT_EQ(seen, "idle");
+
+    r.write<K::COUNT>(3);
+    int c = 0;
+    EXPECT_TRUE(r.read<K::COUNT>(c));
+}
+
+// Every written string is "<n>:" followed by n copies of 'x'; readers must
+// never see a length that disagrees with the content.
+TEST(StrReg, ConcurrentReadsAreCoherent)
+{
+    static R r;
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+
+    std::thread w([&]
+                  {
+        char buf[256];
+        for (int i = 0; i < 100000; ++i)
+        {
+            const int n = i % 200;
+            int len = std::snprintf(buf, sizeof buf, "%d:", n);
+            std::memset(buf + len, 'x', n);
+            r.write<K::STATUS>(std::string_view(buf, len + n));
+        }
+        stop = true; });
+
+    std::thread rd([&]
+                   {
+        regbus::FixedString<256> s;
+        while (!stop.load())
+        {
+            if (!r.read<K::STATUS>(s))
+                continue;
+            const std::string_view v = s.view();
+            const auto colon = v.find(':');
+            if (colon == std::string_view::npos ||
+                std::stoi(std::string(v.substr(0, colon))) != int(v.size() - colon - 1))
+                ++bad;
+        } });
+
+    w.join();
+    rd.join();
+    EXPECT_EQ(bad.load(), 0);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "regbus/Sync.hpp"
+
+enum class K : uint8_t
+{
+    A,
+    B,
+    CMD_GO
+};
+
+struct AType
+{
+    int a;
+};
+struct BType
+{
+    float b;
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::A>
+{
+    using type = AType;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::B>
+{
+    using type = BType;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::CMD_GO>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+
+using R = regbus::Registry<K, Traits, K::A, K::B, K::CMD_GO>;
+using Cursor = regbus::SyncCursor<R>;
+
+// Sink that applies straight into a destination registry and logs keys sent.
+struct Bridge
+{
+    R &dst;
+    Cursor &rx;
+    std::vector<K> sent;
+
+    template <typename Tag, typename V>
+    void operator()(Tag, const V &v, uint32_t seq)
+    {
+        sent.push_back(Tag::value);
+        rx.apply<Tag::value>(dst, v, seq);
+    }
+};
+
+TEST(Sync, SeqNewerIsWrapSafe)
+{
+    EXPECT_TRUE(regbus::seq_newer(2, 1));
+    EXPECT_FALSE(regbus::seq_newer(1, 1));
+    EXPECT_FALSE(regbus::seq_newer(1, 2));
+    EXPECT_TRUE(regbus::seq_newer(3, 0xFFFFFFF0u)); // across wrap
+}
+
+// A fresh or reset cursor (0) takes any seq, even one 2^31 or more past 0
+TEST(Sync, FreshCursorTakesHighSeq)
+{
+    EXPECT_TRUE(regbus::seq_ahead_of_cursor(0x80000001u, 0));
+    EXPECT_TRUE(regbus::seq_ahead_of_cursor(0xFFFFFFFFu, 0));
+    EXPECT_FALSE(regbus::seq_ahead_of_cursor(0, 0));
+    EXPECT_TRUE(regbus::seq_ahead_of_cursor(3, 0xFFFFFFF0u));
+
+    R dst;
+    Cursor rx;
+    EXPECT_TRUE(rx.apply<K::A>(dst, {5}, 0x80000005u));
+    EXPECT_EQ(rx.get<K::A>(), 0x80000005u);
+    EXPECT_FALSE(rx.apply<K::A>(dst, {6}, 0x80000005u)); // duplicate
+    rx.reset();
+    EXPECT_TRUE(rx.apply<K::A>(dst, {7}, 0x80000005u));
+}
+
+TEST(Sync, FirstSyncSendsWrittenKeysOnly)
+{
+    R src, dst;
+    Cursor tx, rx;
+    src.write<K::A>({7});
+
+    Bridge b{dst, rx, {}};
+    EXPECT_EQ(regbus::sync_newer(src, tx, b), 1u);
+    ASSERT_EQ(b.sent.size(), 1u);
+    EXPECT_EQ(b.sent[0], K::A);
+
+    AType a{};
+    ASSERT_TRUE(dst.read<K::A>(a));
+    EXPECT_EQ(a.a, 7);
+    EXPECT_FALSE(dst.has<K::B>());
+}
+
+TEST(Sync, ReconnectSendsOnlyNewerValues)
+{
+    R src, dst;
+    Cursor rx;
+    src.write<K::A>({1});
+    src.write<K::B>({1.5f});
+
+    {
+        Cursor tx;
+        Bridge b{dst, rx, {}};
+        EXPECT_EQ(regbus::sync_newer(src, tx, b), 2u);
+    }
+
+    // Link drops; only B changes meanwhile.
+    src.write<K::B>({2.5f});
+
+    // Reconnect: receiver announces its cursor, sender seeds from it.
+    uint8_t wire[Cursor::encoded_bytes];
+    rx.encode(wire);
+    Cursor tx;
+    ASSERT_TRUE(tx.decode(wire, sizeof(wire)));
+
+    Bridge b{dst, rx, {}};
+    EXPECT_EQ(regbus::sync_newer(src, tx, b), 1u);
+    ASSERT_EQ(b.sent.size(), 1u);
+    EXPECT_EQ(b.sent[0], K::B);
+
+    BType v{};
+    ASSERT_TRUE(dst.read<K::B>(v));
+    EXPECT_FLOAT_EQ(v.b, 2.5f);
+
+    // Nothing new: nothing sent.
+    EXPECT_EQ(regbus::sync_newer(src, tx, b), 0u);
+}
+
+TEST(Sync, ApplyDropsStaleValues)
+{
+    R dst;
+    Cursor rx;
+    EXPECT_TRUE(rx.apply<K::A>(dst, {5}, 10));
+    EXPECT_FALSE(rx.apply<K::A>(dst, {4}, 9));
+    EXPECT_FALSE(rx.apply<K::A>(dst, {4}, 10));
+
+    AType a{};
+    ASSERT_TRUE(dst.read<K::A>(a));
+    EXPECT_EQ(a.a, 5);
+    EXPECT_EQ(rx.get<K::A>(), 10u);
+}
+
+TEST(Sync, DecodeRejectsMismatchedKeyCount)
+{
+    Cursor c;
+    c.set(0, 42);
+    uint8_t wire[Cursor::encoded_bytes] = {};
+    wire[0] = 99; // wrong key count
+    EXPECT_FALSE(c.decode(wire, sizeof(wire)));
+    EXPECT_EQ(c.get(0), 0u); // fell back to full sync
+}
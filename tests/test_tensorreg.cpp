@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "regbus/Registry.hpp"
+
+using Cov = regbus::Tensor<float, 6, 6>;
+using Act = regbus::Tensor<float, 1024>;
+
+enum class K : uint8_t
+{
+    COV,
+    ACT
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::COV>
+{
+    using type = Cov;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::ACT>
+{
+    using type = Act;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+using R = regbus::Registry<K, Traits, K::COV, K::ACT>;
+
+TEST(Tensor, ShapeAndIndexing)
+{
+    static_assert(Cov::rank == 2 && Cov::size == 36, "");
+    static_assert(Cov::extent[0] == 6 && Cov::extent[1] == 6, "");
+    static_assert(alignof(Cov) == 64, "");
+    static_assert(std::is_trivially_copyable<Cov>::value, "");
+    Cov c{};
+    c(2, 3) = 5.f;
+    EXPECT_EQ(c.data[2 * 6 + 3], 5.f);
+    regbus::Tensor<int, 2, 3, 4> t{};
+    t(1, 2, 3) = 7;
+    EXPECT_EQ(t.data[1 * 12 + 2 * 4 + 3], 7);
+}
+
+TEST(Tensor, StreamCopyMatchesMemcpy)
+{
+    for (std::size_t n : {0u, 1u, 63u, 64u, 127u, 128u, 1000u, 4096u, 300000u})
+    {
+        std::vector<uint8_t> src(n + 1), dst(n + 64, 0);
+        for (std::size_t i = 0; i < n; ++i)
+            src[i] = uint8_t(i * 31 + 7);
+        uint8_t *d = dst.data() + (64 - reinterpret_cast<uintptr_t>(dst.data()) % 64) % 64;
+        regbus::stream_copy(d, src.data(), n);
+        EXPECT_EQ(std::memcmp(d, src.data(), n), 0) << n;
+        regbus::stream_copy(d + 1, src.data(), n / 2); // misaligned: plain head, streamed body
+        EXPECT_EQ(std::memcmp(d + 1, src.data(), n / 2), 0) << n;
+    }
+}
+
+TEST(TensorReg, RegistryRoundTripAndViews)
+{
+    auto r = std::make_unique<R>();
+    Cov c{};
+    EXPECT_FALSE(r->read<K::COV>(c));
+    for (int i = 0; i < 6; ++i)
+        c(i, i) = float(i + 1);
+    r->write<K::COV>(c);
+
+    Cov out{};
+    uint32_t seq = 0;
+    ASSERT_TRUE(r->read<K::COV>(out, &seq));
+    EXPECT_EQ(seq, 1u);
+    EXPECT_EQ(out(5, 5), 6.f);
+
+    float trace = 0;
+    ASSERT_TRUE(r->visit<K::COV>([&](const Cov &m)
+                                 {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(m.data) % 64, 0u); // aligned slot
+        trace = 0;
+        for (int i = 0; i < 6; ++i)
+            trace += m(i, i); }));
+    EXPECT_EQ(trace, 21.f);
+
+    r->write_in_place<K::ACT>([](Act &a)
+                              {
+        for (std::size_t i = 0; i < Act::size; ++i)
+            a.data[i] = float(i); });
+    EXPECT_EQ(r->seq<K::ACT>(), 1u);
+    float last = 0;
+    r->visit<K::ACT>([&](const Act &a)
+                     { last = a.data[1023]; });
+    EXPECT_EQ(last, 1023.f);
+}
+
+// Large (streamed) payloads stay coherent under concurrent reads
+TEST(TensorReg, LargePayloadIsCoherent)
+{
+    using Big = regbus::Tensor<uint32_t, 128 * 1024>; // 512 KiB: above the NT threshold
+    auto reg = std::make_unique<regbus::TensorReg<Big>>();
+    auto src = std::make_unique<Big>();
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0}, reads{0};
+
+    std::thread w([&]
+                  {
+        for (uint32_t v = 1; v <= 200; ++v)
+        {
+            std::fill(src->begin(), src->end(), v);
+            reg->write(*src);
+        }
+        stop = true; });
+
+    std::thread rd([&]
+                   {
+        auto out = std::make_unique<Big>();
+        while (!stop.load())
+        {
+            if (!reg->read(*out))
+                continue;
+            const uint32_t v = out->data[0];
+            if (out->data[Big::size / 2] != v || out->data[Big::size - 1] != v)
+                ++bad;
+            ++reads;
+        } });
+
+    w.join();
+    rd.join();
+    EXPECT_EQ(bad.load(), 0);
+    auto out = std::make_unique<Big>();
+    ASSERT_TRUE(reg->read(*out));
+    EXPECT_EQ(out->data[12345], 200u);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+#include "regbus/TimerWheel.hpp"
+
+enum class K : uint8_t
+{
+    RESET,
+    BEAT,
+    SETPOINT
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::RESET>
+{
+    using type = int;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+template <>
+struct Traits<K::BEAT>
+{
+    using type = uint32_t;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+template <>
+struct Traits<K::SETPOINT>
+{
+    using type = double;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+
+using R = regbus::Registry<K, Traits, K::RESET, K::BEAT, K::SETPOINT>;
+using W = regbus::TimerWheel<R, 8>;
+
+TEST(TimerWheel, OneShotPostAndWrite)
+{
+    R r;
+    W w(1000, 0); // 1 ms ticks, simulated clock from 0
+    w.post_at<K::RESET>(5000, 7);
+    w.write_at<K::SETPOINT>(3000, 1.5);
+    EXPECT_EQ(w.active(), 2u);
+
+    EXPECT_EQ(w.tick(r, 2999), 0u);
+    EXPECT_FALSE(r.has<K::SETPOINT>());
+    EXPECT_EQ(w.tick(r, 3000), 1u);
+    double d = 0;
+    EXPECT_TRUE(r.read<K::SETPOINT>(d));
+    EXPECT_EQ(d, 1.5);
+
+    int v = 0;
+    EXPECT_FALSE(r.consume<K::RESET>(v));
+    EXPECT_EQ(w.tick(r, 5000), 1u);
+    EXPECT_TRUE(r.consume<K::RESET>(v));
+    EXPECT_EQ(v, 7);
+    EXPECT_EQ(w.active(), 0u);
+}
+
+TEST(TimerWheel, PeriodicAndCancel)
+{
+    R r;
+    W w(1000, 0);
+    auto h = w.post_every<K::BEAT>(1000, 2000, 1u);
+    std::size_t fired = 0;
+    uint32_t v;
+    for (uint64_t t = 0; t <= 10000; t += 1000)
+    {
+        fired += w.tick(r, t);
+        r.consume<K::BEAT>(v);
+    }
+    EXPECT_EQ(fired, 5u); // 1, 3, 5, 7, 9 ms
+    EXPECT_TRUE(w.cancel(h));
+    EXPECT_FALSE(w.cancel(h)); // already gone
+    EXPECT_EQ(w.tick(r, 20000), 0u);
+}
+
+TEST(TimerWheel, StaleHandleAndPoolExhaustion)
+{
+    R r;
+    W w(1000, 0);
+    auto a = w.post_at<K::RESET>(1000, 1);
+    w.tick(r, 1000); // fires, slot returns to the pool
+    auto b = w.post_at<K::RESET>(2000, 2);
+    EXPECT_EQ(a.idx, b.idx);
+    EXPECT_FALSE(w.cancel(a)); // generation moved on
+    EXPECT_TRUE(w.cancel(b));
+
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(w.post_at<K::RESET>(5000, i));
+    EXPECT_FALSE(w.post_at<K::RESET>(5000, 9)); // fixed capacity
+}
+
+// Timers across every level (and past the wheel range) fire exactly on their tick
+TEST(TimerWheel, CascadesAcrossLevels)
+{
+    R r;
+    regbus::TimerWheel<R, 16> w(1, 0);
+    const uint64_t due[] = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000, (1u << 24) + 5};
+    for (uint64_t t : due)
+        w.write_at<K::SETPOINT>(t, double(t));
+
+    for (uint64_t t : due)
+    {
+        EXPECT_EQ(w.tick(r, t - 1), 0u) << t;
+        EXPECT_EQ(w.tick(r, t), 1u) << t;
+        double d = 0;
+        EXPECT_TRUE(r.read<K::SETPOINT>(d));
+        EXPECT_EQ(d, double(t));
+    }
+    EXPECT_EQ(w.active(), 0u);
+}
+
+TEST(TimerWheel, ServiceThread)
+{
+    auto r = std::make_unique<R>();
+    W w(500, W::steady_now_us());
+    w.post_at<K::RESET>(W::steady_now_us() + 2000, 3);
+    w.start(*r);
+    int v = 0;
+    const uint64_t deadline = W::steady_now_us() + 2000000;
+    while (!r->consume<K::RESET>(v) && W::steady_now_us() < deadline)
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    w.stop();
+    EXPECT_EQ(v, 3);
+}
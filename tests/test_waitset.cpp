@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "regbus/Registry.hpp"
+
+enum class K : uint8_t
+{
+    TEMP,
+    PRESSURE,
+    FAULTS,
+    STOP,
+    TRACK
+};
+
+template <K KK>
+struct Traits;
+template <>
+struct Traits<K::TEMP>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::PRESSURE>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Data;
+};
+template <>
+struct Traits<K::FAULTS>
+{
+    static constexpr regbus::Kind kind = regbus::Kind::Bits;
+    static constexpr std::size_t bits = 64;
+    using type = bool;
+};
+template <>
+struct Traits<K::STOP>
+{
+    using type = bool;
+    static constexpr regbus::Kind kind = regbus::Kind::Cmd;
+};
+template <>
+struct Traits<K::TRACK>
+{
+    using type = float;
+    static constexpr regbus::Kind kind = regbus::Kind::Ring;
+};
+
+using R = regbus::Registry<K, Traits, K::TEMP, K::PRESSURE, K::FAULTS, K::STOP, K::TRACK>;
+
+static void later(int us, std::function<void()> f, std::thread &t)
+{
+    t = std::thread([us, f]
+                    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        f(); });
+}
+
+TEST(WaitSet, AnyReportsWhichFired)
+{
+    R r;
+    r.write<K::TEMP>(20.f); // before the set: not an event
+    auto ws = r.wait_set<K::TEMP, K::PRESSURE, K::FAULTS, K::STOP>();
+    EXPECT_FALSE(r.wait_any(ws, 5000)); // nothing changed
+
+    std::thread t;
+    later(2000, [&]
+          { r.write<K::PRESSURE>(1.2f); }, t);
+    EXPECT_TRUE(r.wait_any(ws, 2000000));
+    t.join();
+    EXPECT_TRUE(ws.fired(R::index<K::PRESSURE>()));
+    EXPECT_FALSE(ws.fired(R::index<K::TEMP>()));
+    EXPECT_FALSE(r.wait_any(ws, 1000)); // cursor advanced
+
+    r.set<K::FAULTS>(3);
+    r.write<K::TEMP>(21.f);
+    EXPECT_TRUE(r.wait_any(ws));
+    std::vector<std::size_t> fired;
+    ws.for_each_fired([&](std::size_t i)
+                      { fired.push_back(i); });
+    EXPECT_EQ(fired, (std::vector<std::size_t>{R::index<K::TEMP>(), R::index<K::FAULTS>()}));
+
+    // Cmd keys are level-triggered: fire while pending
+    r.post<K::STOP>(true);
+    EXPECT_TRUE(r.wait_any(ws, 1000));
+    EXPECT_TRUE(ws.fired(R::index<K::STOP>()));
+    EXPECT_TRUE(r.wait_any(ws, 1000));
+    bool b;
+    r.consume<K::STOP>(b);
+    EXPECT_FALSE(r.wait_any(ws, 1000));
+}
+
+TEST(WaitSet, AllWaitsForEveryKey)
+{
+    R r;
+    auto ws = r.wait_set<K::TEMP, K::PRESSURE>();
+    r.write<K::TEMP>(1.f);
+    EXPECT_FALSE(r.wait_all(ws, 2000)); // TEMP only
+    EXPECT_TRUE(ws.fired(R::index<K::TEMP>()));
+
+    std::thread t;
+    later(2000, [&]
+          { r.write<K::PRESSURE>(2.f); }, t);
+    EXPECT_TRUE(r.wait_all(ws, 2000000));
+    t.join();
+    EXPECT_TRUE(ws.fired(R::index<K::TEMP>()) && ws.fired(R::index<K::PRESSURE>()));
+}
+
+TEST(WaitSet, RuntimeKeyList)
+{
+    R r;
+    R::wait_set_t ws;
+    EXPECT_TRUE(r.watch(ws, R::index<K::PRESSURE>()));
+    EXPECT_FALSE(r.watch(ws, R::index<K::TRACK>())); // Ring keys cannot be waited on
+    EXPECT_FALSE(r.watch(ws, 99));
+    r.write<K::TEMP>(5.f); // not watched
+    EXPECT_FALSE(r.wait_any(ws, 1000));
+    r.write<K::PRESSURE>(5.f);
+    EXPECT_TRUE(r.wait_any(ws, 1000));
+}
+
+// One supervisor over several busy writers: every change is eventually
+// observed and no wakeup is lost (the waiter would time out).
+TEST(WaitSet, NoLostWakeups)
+{
+    R r;
+    auto ws = r.wait_set<K::TEMP, K::PRESSURE>();
+    constexpr int n = 300;
+    std::atomic<int> acked{0};
+    std::thread w([&]
+                  {
+        for (int i = 1; i <= n; ++i)
+        {
+            (i & 1 ? r.write<K::TEMP>(float(i)) : r.write<K::PRESSURE>(float(i)));
+            while (acked.load() < i)
+                std::this_thread::yield();
+        } });
+    int seen = 0;
+    while (seen < n)
+    {
+        ASSERT_TRUE(r.wait_any(ws, 2000000)) << "lost wakeup after " << seen;
+        ws.for_each_fired([&](std::size_t)
+                          { ++seen; });
+        acked.store(seen);
+    }
+    w.join();
+    EXPECT_EQ(seen, n);
+}